@@ -0,0 +1,347 @@
+/*
+ * Microbenchmarks for the event system. Does not open a window.
+ *
+ * Usage: gl_base_benchmark [output.json]
+ *
+ * Writes the results as JSON to the given file, or to stdout if no file
+ * is given. Progress is printed to stderr.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "glb/event/EventHandler.h"
+#include "glb/event/InputEvents.h"
+#include "glb/event/Listener.h"
+
+using namespace glb;
+
+
+
+namespace
+{
+	constexpr size_t NOTIFY_EVENT_COUNT = 2000000;
+	constexpr size_t DISPATCH_BATCH_SIZE = 4096;
+	constexpr size_t DISPATCH_ROUNDS = 200;
+	constexpr size_t TYPE_CHECK_EVENT_COUNT = 1000000;
+	constexpr size_t TYPE_CHECK_ROUNDS = 20;
+	constexpr size_t LATENCY_SAMPLES = 200000;
+	constexpr auto LATENCY_INTERVAL = std::chrono::microseconds(20);
+
+	/**
+	 * A single benchmark result. Values are stored as JSON literals.
+	 */
+	struct Result
+	{
+		std::string name;
+		std::vector<std::pair<std::string, std::string>> values;
+	};
+
+	std::vector<Result> results;
+
+	auto number(double value) -> std::string
+	{
+		char buf[64];
+		std::snprintf(buf, sizeof(buf), "%.9g", value);
+		return buf;
+	}
+
+	auto text(const std::string& value) -> std::string
+	{
+		return '"' + value + '"';
+	}
+
+	auto toSeconds(Clock::duration d) -> double
+	{
+		return std::chrono::duration<double>(d).count();
+	}
+
+	void report(Result result)
+	{
+		std::fprintf(stderr, "%s:", result.name.c_str());
+		for (const auto& [key, value] : result.values) {
+			std::fprintf(stderr, " %s=%s", key.c_str(), value.c_str());
+		}
+		std::fprintf(stderr, "\n");
+
+		results.push_back(std::move(result));
+	}
+
+	void writeJson(FILE* file)
+	{
+		std::fprintf(file, "{\n");
+		std::fprintf(file, "  \"suite\": \"gl_base event system\",\n");
+		std::fprintf(file, "  \"hardware_concurrency\": %u,\n", std::thread::hardware_concurrency());
+		std::fprintf(file, "  \"results\": [\n");
+		for (size_t i = 0; i < results.size(); i++)
+		{
+			const Result& result = results[i];
+			std::fprintf(file, "    { \"name\": %s", text(result.name).c_str());
+			for (const auto& [key, value] : result.values) {
+				std::fprintf(file, ", %s: %s", text(key).c_str(), value.c_str());
+			}
+			std::fprintf(file, " }%s\n", i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n");
+		std::fprintf(file, "}\n");
+	}
+
+	auto makeCreateInfo(EventDispatchMode mode, size_t queueCapacity)
+		-> EventHandler::EventHandlerCreateInfo
+	{
+		EventHandler::EventHandlerCreateInfo info;
+		info.dispatchMode = mode;
+		info.queueCapacity = queueCapacity;
+		return info;
+	}
+
+
+
+	/**
+	 * Throughput of notify() with several producer threads that compete
+	 * for the queue. Measured until the last event has been delivered.
+	 */
+	void benchmarkNotify(uint32_t producerCount)
+	{
+		EventHandler::init(makeCreateInfo(EventDispatchMode::asynchronous, 1 << 16));
+
+		std::atomic<size_t> received{ 0 };
+		auto sub = EventHandler::subscribe<MouseMoveEvent>([&](const MouseMoveEvent&) {
+			received.fetch_add(1, std::memory_order_relaxed);
+		});
+
+		const size_t perProducer = NOTIFY_EVENT_COUNT / producerCount;
+		const size_t total = perProducer * producerCount;
+
+		std::atomic<bool> start{ false };
+		std::vector<std::thread> producers;
+		for (uint32_t i = 0; i < producerCount; i++)
+		{
+			producers.emplace_back([&]() {
+				while (!start.load()) std::this_thread::yield();
+				for (size_t n = 0; n < perProducer; n++) {
+					EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(n), 0.0f)));
+				}
+			});
+		}
+
+		const auto begin = Clock::now();
+		start = true;
+		for (auto& t : producers) {
+			t.join();
+		}
+		while (received.load(std::memory_order_relaxed) < total) {
+			std::this_thread::yield();
+		}
+		const double seconds = toSeconds(Clock::now() - begin);
+
+		sub.unsubscribe();
+		EventHandler::terminate();
+
+		report({ "notify_throughput", {
+			{ "producers", number(producerCount) },
+			{ "events", number(static_cast<double>(total)) },
+			{ "seconds", number(seconds) },
+			{ "events_per_second", number(static_cast<double>(total) / seconds) },
+		}});
+	}
+
+
+
+	class CountingListener : public Listener
+	{
+	public:
+		void onEvent(const Event&) override {
+			count++;
+		}
+
+		size_t count{ 0 };
+	};
+
+	/**
+	 * Cost of dispatching a batch to a number of listeners. Uses
+	 * synchronous dispatch so that only dispatchEvents() is timed.
+	 */
+	void benchmarkDispatch(uint32_t listenerCount)
+	{
+		EventHandler::init(makeCreateInfo(EventDispatchMode::synchronous, DISPATCH_BATCH_SIZE));
+
+		std::vector<std::unique_ptr<CountingListener>> listeners;
+		for (uint32_t i = 0; i < listenerCount; i++) {
+			listeners.push_back(std::make_unique<CountingListener>());
+		}
+
+		Clock::duration elapsed{ 0 };
+		for (size_t round = 0; round < DISPATCH_ROUNDS; round++)
+		{
+			for (size_t n = 0; n < DISPATCH_BATCH_SIZE; n++) {
+				EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(n), 0.0f)));
+			}
+
+			const auto begin = Clock::now();
+			EventHandler::dispatchEvents();
+			elapsed += Clock::now() - begin;
+		}
+
+		listeners.clear();
+		EventHandler::terminate();
+
+		const double events = static_cast<double>(DISPATCH_BATCH_SIZE * DISPATCH_ROUNDS);
+		const double seconds = toSeconds(elapsed);
+		report({ "dispatch_throughput", {
+			{ "listeners", number(listenerCount) },
+			{ "events", number(events) },
+			{ "seconds", number(seconds) },
+			{ "events_per_second", number(events / seconds) },
+			{ "deliveries_per_second", number(events * listenerCount / seconds) },
+		}});
+	}
+
+
+
+	// Returns the index of the first type in the chain that the event is
+	// an instance of, or -1
+	template<class... Ts>
+	auto matchChain(const Event& e) noexcept -> int
+	{
+		int index = 0;
+		const bool found = ((e.is<Ts>() || (index++, false)) || ...);
+		return found ? index : -1;
+	}
+
+	/**
+	 * Cost of a listener that tells events apart with a chain of
+	 * Event::is<T>() checks. The events always match the last type of the
+	 * chain, which is the worst case.
+	 */
+	template<class Last, class... Ts>
+	void benchmarkTypeChain()
+	{
+		constexpr size_t chainLength = sizeof...(Ts) + 1;
+
+		std::vector<std::unique_ptr<Event>> events;
+		for (size_t i = 0; i < TYPE_CHECK_EVENT_COUNT; i++) {
+			events.push_back(std::make_unique<Last>(vec2(0.0f), vec2(0.0f)));
+		}
+
+		int64_t sink = 0;
+		const auto begin = Clock::now();
+		for (size_t round = 0; round < TYPE_CHECK_ROUNDS; round++)
+		{
+			for (const auto& e : events) {
+				sink += matchChain<Ts..., Last>(*e);
+			}
+		}
+		const double seconds = toSeconds(Clock::now() - begin);
+
+		if (sink != static_cast<int64_t>((chainLength - 1) * TYPE_CHECK_EVENT_COUNT * TYPE_CHECK_ROUNDS)) {
+			std::fprintf(stderr, "Type check chain returned wrong results\n");
+		}
+
+		const double checks = static_cast<double>(TYPE_CHECK_EVENT_COUNT * TYPE_CHECK_ROUNDS);
+		report({ "is_chain", {
+			{ "chain_length", number(chainLength) },
+			{ "events", number(checks) },
+			{ "ns_per_event", number(seconds * 1e9 / checks) },
+		}});
+	}
+
+
+
+	/**
+	 * Time from the creation of an event to its delivery to a subscriber
+	 * in asynchronous mode. Events are either sent at a fixed interval,
+	 * which leaves the dispatcher idle in between, or in a single burst.
+	 */
+	void benchmarkLatency(bool burst)
+	{
+		EventHandler::init(makeCreateInfo(EventDispatchMode::asynchronous, 1 << 16));
+
+		// Only written by the event handler thread
+		std::vector<int64_t> samples;
+		samples.reserve(LATENCY_SAMPLES);
+		std::atomic<size_t> received{ 0 };
+		auto sub = EventHandler::subscribe<MouseMoveEvent>([&](const MouseMoveEvent& e) {
+			const auto latency = Clock::now() - e.getTimestamp();
+			samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+			received.fetch_add(1, std::memory_order_release);
+		});
+
+		auto next = Clock::now();
+		for (size_t n = 0; n < LATENCY_SAMPLES; n++)
+		{
+			if (!burst)
+			{
+				next += LATENCY_INTERVAL;
+				while (Clock::now() < next) {}
+			}
+			EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(n), 0.0f)));
+		}
+		while (received.load(std::memory_order_acquire) < LATENCY_SAMPLES) {
+			std::this_thread::yield();
+		}
+
+		sub.unsubscribe();
+		EventHandler::terminate();
+
+		std::sort(samples.begin(), samples.end());
+		auto percentile = [&](double p) {
+			const auto index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+			return number(static_cast<double>(samples[index]));
+		};
+
+		report({ "delivery_latency", {
+			{ "pattern", text(burst ? "burst" : "paced") },
+			{ "events", number(static_cast<double>(samples.size())) },
+			{ "p50_ns", percentile(0.5) },
+			{ "p90_ns", percentile(0.9) },
+			{ "p99_ns", percentile(0.99) },
+			{ "p999_ns", percentile(0.999) },
+			{ "max_ns", number(static_cast<double>(samples.back())) },
+		}});
+	}
+} // anonymous namespace
+
+
+
+int main(int argc, char** argv)
+{
+	for (uint32_t producers : { 1, 4, 16 }) {
+		benchmarkNotify(producers);
+	}
+	for (uint32_t listeners : { 1, 10, 100 }) {
+		benchmarkDispatch(listeners);
+	}
+
+	benchmarkTypeChain<MouseMotionEvent>();
+	benchmarkTypeChain<MouseMotionEvent, KeyPressEvent, KeyReleaseEvent, MouseMoveEvent>();
+	benchmarkTypeChain<MouseMotionEvent, KeyPressEvent, KeyReleaseEvent, MouseButtonPressEvent,
+					   MouseButtonReleaseEvent, MouseMoveEvent, MouseScrollEvent>();
+
+	benchmarkLatency(false);
+	benchmarkLatency(true);
+
+	if (argc > 1)
+	{
+		FILE* file = std::fopen(argv[1], "w");
+		if (file == nullptr)
+		{
+			std::fprintf(stderr, "Unable to open %s for writing\n", argv[1]);
+			return 1;
+		}
+		writeJson(file);
+		std::fclose(file);
+	}
+	else {
+		writeJson(stdout);
+	}
+
+	return 0;
+}
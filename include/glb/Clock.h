@@ -0,0 +1,18 @@
+#pragma once
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <chrono>
+
+namespace glb
+{
+    /**
+     * @brief The clock used for all timestamps and time measurements
+     *
+     * Monotonic, so timestamps can be compared and subtracted safely even
+     * if the system time changes.
+     */
+    using Clock = std::chrono::steady_clock;
+} // namespace glb
+
+#endif
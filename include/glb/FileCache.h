@@ -0,0 +1,60 @@
+#pragma once
+#ifndef FILECACHE_H
+#define FILECACHE_H
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <mutex>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace glb
+{
+    /**
+     * @brief Holds the contents of files that have been read ahead of use
+     *
+     * Window::create() reads WindowCreateInfo::prefetchFiles into the
+     * cache while the OpenGL context is created. ShaderLoader and Texture
+     * take a file's contents from the cache instead of reading it from
+     * disk if it is there.
+     *
+     * An entry is removed when it is taken, so a file that is loaded again
+     * later is read from disk with its current contents. Window::close()
+     * clears the cache, so prefetched files that were never used don't
+     * outlive the window.
+     *
+     * Thread safe.
+     */
+    class FileCache
+    {
+    public:
+        /**
+         * @brief Read files into the cache
+         *
+         * Files that cannot be read are skipped.
+         */
+        static void prefetch(const std::vector<fs::path>& files);
+
+        /**
+         * @brief Remove a file's contents from the cache
+         *
+         * @return std::optional<std::string> The contents of the file if it
+         *                                    has been prefetched
+         */
+        [[nodiscard]]
+        static auto take(const fs::path& file) -> std::optional<std::string>;
+
+        /**
+         * @brief Remove all files from the cache
+         */
+        static void clear();
+
+    private:
+        static inline std::mutex lock;
+        static inline std::unordered_map<std::string, std::string> files;
+    };
+} // namespace glb
+
+#endif
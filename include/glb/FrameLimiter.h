@@ -0,0 +1,98 @@
+#pragma once
+#ifndef FRAMELIMITER_H
+#define FRAMELIMITER_H
+
+#include <chrono>
+#include <atomic>
+
+#include "Clock.h"
+
+namespace glb
+{
+    class Window;
+
+    /**
+     * @brief Limits the frame rate to a target, paced by Window::swapBuffers()
+     *
+     * After the buffer swap, Window::swapBuffers() waits until the target
+     * frame time has passed since the start of the previous frame. Because
+     * the wait happens before the next frame polls its input instead of
+     * before the swap, it adds no input latency, unlike a deep vsync
+     * queue.
+     *
+     * The wait sleeps in short steps for as long as the remaining time is
+     * longer than a step is expected to take, and spins on glb::Clock for
+     * the rest. The expected duration of a step is a rolling estimate of
+     * the measured sleep times plus a safety margin, so it adapts to the
+     * scheduler's timer resolution and to load. This keeps the frame start
+     * within tens of microseconds of the target while the thread sleeps
+     * for most of the wait.
+     *
+     * Frames are paced against a fixed schedule, so short waits make up
+     * for slow frames. A frame that is more than a whole frame time late
+     * restarts the schedule instead of causing a burst of frames.
+     *
+     * Disabled by default. Can be combined with vsync.
+     */
+    class FrameLimiter
+    {
+    public:
+        /**
+         * @param double framesPerSecond The target frame rate. Zero or
+         *                               less disables the limiter.
+         */
+        static void setTargetFrameRate(double framesPerSecond) noexcept;
+
+        /**
+         * @param Clock::duration frameTime The minimum time between the
+         *                                  starts of two frames. Zero
+         *                                  disables the limiter.
+         */
+        static void setTargetFrameTime(Clock::duration frameTime) noexcept;
+
+        [[nodiscard]]
+        static auto getTargetFrameTime() noexcept -> Clock::duration {
+            return Clock::duration(targetFrameTime.load(std::memory_order_relaxed));
+        }
+
+        [[nodiscard]]
+        static bool isEnabled() noexcept {
+            return getTargetFrameTime() > Clock::duration::zero();
+        }
+
+        /**
+         * @return Clock::duration The current estimate of how much longer
+         *                         than requested a sleep step takes. Only
+         *                         call from the main thread.
+         */
+        [[nodiscard]]
+        static auto getSleepOvershootEstimate() -> Clock::duration;
+
+    private:
+        friend Window;
+
+        // Called by Window::swapBuffers() after the swap. Main thread only.
+        static void waitForNextFrame();
+
+        static void preciseSleepUntil(Clock::time_point deadline);
+        static void updateSleepEstimate(Clock::duration measured);
+
+        // A short sleep request that most schedulers can honor
+        static constexpr auto SLEEP_STEP = std::chrono::milliseconds(1);
+
+        // Weight of a new measurement in the rolling sleep estimate
+        static constexpr double ESTIMATE_WEIGHT = 0.1;
+
+        static inline std::atomic<Clock::rep> targetFrameTime{ 0 };
+
+        static inline bool hasFrameStart{ false };
+        static inline Clock::time_point frameStart;
+
+        // Rolling mean and variance of a sleep step in nanoseconds
+        static inline double sleepMean{ 2e6 };
+        static inline double sleepVariance{ 0.0 };
+        static inline Clock::duration sleepEstimate{ std::chrono::milliseconds(2) };
+    };
+} // namespace glb
+
+#endif
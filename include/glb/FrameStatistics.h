@@ -0,0 +1,191 @@
+#pragma once
+#ifndef FRAMESTATISTICS_H
+#define FRAMESTATISTICS_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "Clock.h"
+
+namespace glb
+{
+    class Window;
+
+    constexpr size_t DEFAULT_FRAME_HISTORY_SIZE = 1024;
+    constexpr double DEFAULT_HITCH_FACTOR = 2.0;
+
+    /**
+     * @brief The timing of a single frame
+     */
+    struct FrameTiming
+    {
+        // Number of the frame since program start or the last reset
+        uint64_t frame{ 0 };
+
+        // From the start of the frame to the start of this swap. The time
+        // the CPU spent on the frame. A frame starts when the previous
+        // Window::swapBuffers() returns, after the waits for frames in
+        // flight and for the FrameLimiter.
+        Clock::duration cpuFrameTime{ 0 };
+
+        // Time blocked in glfwSwapBuffers()
+        Clock::duration swapTime{ 0 };
+
+        // Time spent waiting on the fence of an earlier frame after the
+        // swap. See Window::setMaxFramesInFlight().
+        Clock::duration fenceWaitTime{ 0 };
+
+        // From the return of the previous swap to the return of this one.
+        // The time between two presented frames.
+        Clock::duration presentInterval{ 0 };
+
+        // True if the present interval was more than the hitch factor
+        // times the rolling mean
+        bool hitch{ false };
+    };
+
+    /**
+     * @brief Rolling statistics of one duration over the frame history
+     */
+    struct FrameDurationStatistics
+    {
+        Clock::duration mean{ 0 };
+        Clock::duration p95{ 0 };
+        Clock::duration p99{ 0 };
+        Clock::duration max{ 0 };
+    };
+
+    /**
+     * @brief Compute mean, percentiles and maximum of a set of durations
+     *
+     * Sorts the samples. Returns zero for all values if there are none.
+     */
+    auto computeFrameDurationStatistics(std::vector<Clock::duration>& samples)
+        -> FrameDurationStatistics;
+
+    /**
+     * @brief Statistics of the frames in the history
+     */
+    struct FrameStats
+    {
+        // Number of frames in the history
+        size_t frameCount{ 0 };
+
+        // Number of frames recorded since program start or the last reset
+        uint64_t totalFrameCount{ 0 };
+
+        FrameDurationStatistics cpuFrameTime;
+        FrameDurationStatistics swapTime;
+        FrameDurationStatistics fenceWaitTime;
+        FrameDurationStatistics presentInterval;
+
+        // Hitches in the history and since program start or the last reset
+        size_t hitchCount{ 0 };
+        uint64_t totalHitchCount{ 0 };
+    };
+
+    /**
+     * @brief Frame times and frame pacing, recorded by Window::swapBuffers()
+     *
+     * Keeps the timing of the last frames in a ring buffer. Recording a
+     * frame takes constant time and does not allocate. Percentiles are
+     * computed when the statistics are queried.
+     *
+     * A frame is a hitch if its present interval is longer than the hitch
+     * factor times the rolling mean of the present interval. Hitches are
+     * only detected once the history holds a few frames.
+     *
+     * Enabled by default. Queries are thread safe.
+     */
+    class FrameStatistics
+    {
+    public:
+        static void setEnabled(bool enabled) noexcept;
+
+        [[nodiscard]]
+        static bool isEnabled() noexcept {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Set the number of frames in the history
+         *
+         * Clears the history.
+         */
+        static void setHistorySize(size_t frames);
+
+        /**
+         * @param double factor A frame is a hitch if its present interval
+         *                      is longer than factor times the mean
+         */
+        static void setHitchFactor(double factor);
+
+        [[nodiscard]]
+        static auto getStats() -> FrameStats;
+
+        /**
+         * @return FrameTiming The timing of the most recent frame. Zero if
+         *                     no frame has been recorded.
+         */
+        [[nodiscard]]
+        static auto getLastFrame() -> FrameTiming;
+
+        /**
+         * @return std::vector<FrameTiming> The frames in the history, the
+         *                                  oldest first
+         */
+        [[nodiscard]]
+        static auto getHistory() -> std::vector<FrameTiming>;
+
+        /**
+         * @brief Clear the history and all counters
+         */
+        static void reset();
+
+        /**
+         * @brief Write the frames in the history to a CSV file
+         *
+         * One line per frame, the oldest first. Times are in milliseconds.
+         *
+         * @throw std::runtime_error if the file cannot be opened
+         */
+        static void writeCsv(const fs::path& file);
+
+    private:
+        friend Window;
+
+        // Called by Window::swapBuffers() with the time before and after
+        // the buffer swap, the time waited for frames in flight and the
+        // start of the next frame
+        static void recordFrame(Clock::time_point swapBegin,
+                                Clock::time_point swapEnd,
+                                Clock::duration fenceWaitTime,
+                                Clock::time_point nextFrameStart);
+
+        static constexpr size_t MIN_FRAMES_FOR_HITCH_DETECTION = 8;
+
+        static inline std::atomic<bool> enabled{ true };
+
+        static inline std::mutex lock;
+        static inline std::vector<FrameTiming> history;
+        static inline size_t historySize{ DEFAULT_FRAME_HISTORY_SIZE };
+        static inline size_t next{ 0 };
+        static inline size_t count{ 0 };
+        static inline double hitchFactor{ DEFAULT_HITCH_FACTOR };
+
+        // Sum of the present intervals in the history for the rolling mean
+        static inline Clock::duration presentIntervalSum{ 0 };
+
+        static inline uint64_t totalFrameCount{ 0 };
+        static inline uint64_t totalHitchCount{ 0 };
+        static inline Clock::time_point lastSwapEnd;
+        static inline Clock::time_point frameStart;
+        static inline bool hasLastSwap{ false };
+    };
+} // namespace glb
+
+#endif
@@ -0,0 +1,198 @@
+#pragma once
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "Clock.h"
+#include "FrameStatistics.h"
+#include "OpenglResource.h"
+
+namespace glb
+{
+    class Window;
+
+    /**
+     * @brief Rolling GPU time of one zone
+     */
+    struct GpuZoneStatistics
+    {
+        std::string name;
+
+        // The frame that the latest result is from, counted since the
+        // last reset
+        uint64_t frame{ 0 };
+
+        // GPU time of the zone in the latest frame with a result. Summed
+        // if the zone has been entered multiple times in that frame.
+        Clock::duration last{ 0 };
+
+        // Over the last GpuProfiler::ZONE_HISTORY_SIZE frames that
+        // contained the zone
+        FrameDurationStatistics statistics;
+    };
+
+    /**
+     * @brief Measures the GPU time of named zones of a frame
+     *
+     * A zone writes a GL_TIMESTAMP query when it begins and another one
+     * when it ends, so zones may be nested. Use GpuZone to time a scope:
+     *
+     *      {
+     *          GpuZone zone("shadow pass");
+     *          ... draw calls
+     *      }
+     *
+     * The queries of a frame are read back FRAME_LATENCY frames later by
+     * Window::swapBuffers(). Results that are not available by then are
+     * discarded instead of waiting for them, so the profiler never stalls
+     * the CPU on GL_QUERY_RESULT. Query objects are recycled, so zones
+     * only allocate the first time they are used in a frame.
+     *
+     * Disabled by default. While disabled, zones cost a single flag check.
+     * All functions must be called on the OpenGL thread. Requires timer
+     * queries (OpenGL 3.3 or ARB_timer_query). Window::close() deletes
+     * the query objects and disables the profiler.
+     */
+    class GpuProfiler
+    {
+    public:
+        // Number of frames whose queries may be in flight at the same time
+        static constexpr uint32_t FRAME_LATENCY = 4;
+        static constexpr size_t ZONE_HISTORY_SIZE = 128;
+
+        /**
+         * @brief Enable or disable the profiler
+         *
+         * Enabling does nothing if the window is not open or its OpenGL
+         * context doesn't support timer queries.
+         */
+        static void setEnabled(bool enabled);
+
+        [[nodiscard]]
+        static bool isEnabled() noexcept {
+            return enabled;
+        }
+
+        /**
+         * @brief Begin a zone
+         *
+         * Must be matched by a call to endZone() in the same frame.
+         *
+         * @param const char* name The name that identifies the zone
+         */
+        static void beginZone(const char* name);
+
+        /**
+         * @brief End the most recently begun zone
+         */
+        static void endZone();
+
+        /**
+         * @return std::vector<GpuZoneStatistics> All zones that have a
+         *                                        result, in the order in
+         *                                        which they first occurred
+         */
+        [[nodiscard]]
+        static auto getZoneStatistics() -> std::vector<GpuZoneStatistics>;
+
+        /**
+         * @return uint64_t Number of frames whose results were discarded
+         *                  because the GPU had not finished them in time
+         */
+        [[nodiscard]]
+        static auto getDroppedFrameCount() -> uint64_t;
+
+        /**
+         * @brief Discard all results and zones
+         */
+        static void reset();
+
+    private:
+        friend Window;
+
+        // Called by Window::swapBuffers() before the swap
+        static void endFrame();
+
+        // Called by Window::close() while the context is still current
+        static void destroyQueries();
+
+        struct Zone
+        {
+            Zone() {} // GCC and Clang can't handle default ctors in nested structs
+
+            std::string name;
+            uint64_t frame{ 0 };
+            Clock::duration last{ 0 };
+
+            // Ring buffer of per-frame results
+            std::vector<Clock::duration> history;
+            size_t next{ 0 };
+
+            // Results of the frame that is currently read back
+            Clock::duration accumulated{ 0 };
+            bool touched{ false };
+        };
+
+        struct TimedZone
+        {
+            uint32_t zone;
+            uint32_t beginQuery;
+            uint32_t endQuery;
+        };
+
+        struct FrameQueries
+        {
+            FrameQueries() {} // GCC and Clang can't handle default ctors in nested structs
+
+            std::vector<glUniqueQuery> queries;
+            uint32_t usedQueries{ 0 };
+            std::vector<TimedZone> zones;
+            uint64_t frame{ 0 };
+            bool pending{ false };
+        };
+
+        static auto findZone(const char* name) -> uint32_t;
+        static auto writeTimestamp() -> uint32_t;
+        static bool readBack(FrameQueries& frame);
+        static void clear(FrameQueries& frame);
+
+        static inline bool enabled{ false };
+        static inline std::vector<Zone> zones;
+        static inline FrameQueries frames[FRAME_LATENCY];
+        static inline uint32_t currentFrame{ 0 };
+        static inline uint64_t frameNumber{ 0 };
+        static inline uint64_t droppedFrameCount{ 0 };
+
+        // Indices into the current frame's zones of the zones that have
+        // not been ended yet
+        static inline std::vector<uint32_t> openZones;
+        static inline std::vector<uint32_t> touchedZones;
+    };
+
+    /**
+     * @brief Times the GPU work of a scope with the GpuProfiler
+     */
+    class GpuZone
+    {
+    public:
+        explicit GpuZone(const char* name) {
+            GpuProfiler::beginZone(name);
+        }
+
+        GpuZone(const GpuZone&) = delete;
+        GpuZone(GpuZone&&) noexcept = delete;
+        GpuZone& operator=(const GpuZone&) = delete;
+        GpuZone& operator=(GpuZone&&) noexcept = delete;
+
+        ~GpuZone() {
+            GpuProfiler::endZone();
+        }
+    };
+} // namespace glb
+
+#endif
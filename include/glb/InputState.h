@@ -0,0 +1,126 @@
+#pragma once
+#ifndef INPUTSTATE_H
+#define INPUTSTATE_H
+
+#include <cstdint>
+#include <atomic>
+#include <bitset>
+
+#include <glm/glm.hpp>
+using namespace glm;
+
+#include "event/KeyDefinitions.h"
+
+namespace glb
+{
+    /**
+     * @brief The state of all input devices at the end of a frame
+     *
+     * A plain value. Obtained from InputState::getSnapshot().
+     */
+    struct InputSnapshot
+    {
+        static constexpr size_t KEY_COUNT = static_cast<size_t>(eKey::MAX_ENUM) + 1;
+        static constexpr size_t MOUSE_BUTTON_COUNT = static_cast<size_t>(eMouseButton::MAX_ENUM) + 1;
+
+        [[nodiscard]]
+        bool isKeyPressed(eKey key) const noexcept;
+
+        [[nodiscard]]
+        bool isMouseButtonPressed(eMouseButton button) const noexcept;
+
+        std::bitset<KEY_COUNT> keys;
+        std::bitset<MOUSE_BUTTON_COUNT> mouseButtons;
+        vec2 cursorPos{ 0.0f };
+
+        // Accumulated since the previous snapshot. Raw, unaccelerated
+        // motion if the cursor is disabled and raw mouse motion is
+        // enabled, see Window::WindowCreateInfo.
+        vec2 cursorDelta{ 0.0f };
+        vec2 scrollDelta{ 0.0f };
+
+        // Incremented every time a new snapshot is published
+        uint64_t frame{ 0 };
+    };
+
+    /**
+     * @brief Polled input state
+     *
+     * An alternative to listening to input events for logic that only
+     * needs to know which keys are held and where the cursor is.
+     *
+     * The window's callbacks update a working copy of the state on the
+     * thread that calls Window::pollEvents(). At the end of every
+     * pollEvents(), the working copy is published as a new snapshot.
+     * Snapshots are consistent, i.e. they never mix the state of two
+     * frames, and can be read from any thread without locks.
+     *
+     * Example:
+     *
+     *      const InputSnapshot input = InputState::getSnapshot();
+     *      if (input.isKeyPressed(eKey::w)) {
+     *          moveForward(input.cursorDelta);
+     *      }
+     */
+    class InputState
+    {
+    public:
+        /**
+         * @brief Get the most recently published snapshot
+         *
+         * Thread safe and lock-free. Only retries if the snapshot is
+         * replaced twice while it is being copied.
+         */
+        [[nodiscard]]
+        static auto getSnapshot() noexcept -> InputSnapshot;
+
+        [[nodiscard]]
+        static bool isKeyPressed(eKey key) noexcept;
+
+        [[nodiscard]]
+        static bool isMouseButtonPressed(eMouseButton button) noexcept;
+
+        /**
+         * @return vec2 The cursor position of the most recent snapshot
+         */
+        [[nodiscard]]
+        static auto getCursorPos() noexcept -> vec2;
+
+    private:
+        friend class Window;
+
+        // Called by the window's callbacks
+        static void setKey(eKey key, bool pressed) noexcept;
+        static void setMouseButton(eMouseButton button, bool pressed) noexcept;
+        static void setCursorPos(vec2 pos) noexcept;
+        static void resetCursorPos(vec2 pos) noexcept;
+        static void addScroll(vec2 offset) noexcept;
+
+        // Called by Window::pollEvents()
+        static void publish() noexcept;
+
+        static_assert(std::is_trivially_copyable_v<InputSnapshot>);
+        static constexpr size_t WORD_COUNT = (sizeof(InputSnapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        // A seqlock. The sequence is odd while the buffer is written. The
+        // words are atomic so that a reader racing with the writer reads
+        // stale values instead of invoking undefined behaviour.
+        struct Buffer
+        {
+            Buffer() {} // GCC and Clang can't handle default ctors in nested structs
+
+            std::atomic<uint32_t> sequence{ 0 };
+            std::atomic<uint64_t> words[WORD_COUNT]{};
+        };
+
+        // Only accessed by the thread that polls events
+        static inline InputSnapshot working;
+
+        // The writer alternates between the buffers, so readers of the
+        // current buffer are not disturbed by the next publish
+        static inline Buffer buffers[2];
+        static inline std::atomic<uint32_t> current{ 0 };
+    };
+} // namespace glb
+
+#endif
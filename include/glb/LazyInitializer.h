@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <mutex>
 #include <functional>
 #include <type_traits>
 
@@ -28,15 +29,62 @@ namespace glb
          */
         static void addLazyInitializer(std::function<void(void)> func);
 
+        /**
+         * @brief Add an initializer with a part that doesn't need OpenGL
+         *
+         * The prepare function runs on a background thread while the
+         * OpenGL context is created, for example to read and parse files.
+         * The OpenGL function runs afterwards in the thread that created
+         * the context, as with the single-function overload. Prepare
+         * functions run one after another, but concurrently with the rest
+         * of Window::create(). They must not call OpenGL. DevIL has been
+         * initialized when they run.
+         *
+         * If the window has already been created, both functions are
+         * called immediately. Initializers that are added while the
+         * window is being created are prepared in the thread that creates
+         * the context.
+         *
+         * @param std::function<void(void)> prepare Context-independent
+         *                                          work
+         * @param std::function<void(void)> glInit  Work that requires the
+         *                                          OpenGL context
+         */
+        static void addLazyInitializer(std::function<void(void)> prepare,
+                                       std::function<void(void)> glInit);
+
     private:
         friend class Window;
 
+        struct Initializer
+        {
+            std::function<void(void)> prepare;
+            std::function<void(void)> glInit;
+        };
+
+        /**
+         * Returns a copy of all lazy initializers. Window passes it to
+         * prepareAll(), so that initializers can be added while the
+         * background thread prepares the copy.
+         */
+        static auto getInitializers() -> std::vector<Initializer>;
+
+        /**
+         * Calls the prepare functions of the given lazy initializers.
+         * Called by Window on a background thread.
+         */
+        static void prepareAll(const std::vector<Initializer>& initializers);
+
         /**
-         * Calls all lazy initializers. Called by Window.
+         * Calls all lazy initializers. Called by Window after
+         * prepareAll() has returned. The first preparedCount initializers
+         * have been prepared by it, the prepare functions of the rest are
+         * called here.
          */
-        static void initAll();
+        static void initAll(size_t preparedCount);
 
-        static inline std::vector<std::function<void(void)>> lazyInitializers;
+        static inline std::mutex lock;
+        static inline std::vector<Initializer> lazyInitializers;
     };
 
     /**
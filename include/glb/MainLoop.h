@@ -0,0 +1,120 @@
+#pragma once
+#ifndef MAINLOOP_H
+#define MAINLOOP_H
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+
+#include "Clock.h"
+
+namespace glb
+{
+    constexpr double DEFAULT_TICK_RATE = 60.0;
+    constexpr uint32_t DEFAULT_MAX_TICKS_PER_FRAME = 8;
+
+    /**
+     * @brief Drives the window's frames with a fixed simulation timestep
+     *
+     * Runs until the window is closed or MainLoop::stop() is called. Each
+     * frame:
+     *
+     * 1. Polls events with Window::pollEvents()
+     *
+     * 2. Runs the update hook once for every whole tick that has elapsed
+     *    since the last frame
+     *
+     * 3. Clears the back buffer and runs the render hook with the
+     *    interpolation alpha, the fraction of a tick that has elapsed
+     *    since the last update. Blend the previous and the current
+     *    simulation state with it for smooth motion at any frame rate.
+     *
+     * 4. Swaps the buffers with Window::swapBuffers() and runs the idle
+     *    hook
+     *
+     * The updates of a frame run while the GPU still renders the previous
+     * frames. Window::swapBuffers() bounds how far the CPU may run ahead,
+     * see Window::setMaxFramesInFlight().
+     *
+     * If a frame takes so long that more than maxTicksPerFrame ticks are
+     * due, the surplus time is dropped. The simulation then runs slower
+     * than real time instead of falling further behind with every frame.
+     */
+    struct MainLoopCreateInfo
+    {
+        // Simulation ticks per second
+        double tickRate{ DEFAULT_TICK_RATE };
+
+        // Maximum number of updates per frame
+        uint32_t maxTicksPerFrame{ DEFAULT_MAX_TICKS_PER_FRAME };
+
+        // Call Window::clear() before the render hook
+        bool clearBackBuffer{ true };
+
+        // Called once per tick with the tick duration in seconds
+        std::function<void(double)> update;
+
+        // Called once per frame with the interpolation alpha in [0, 1)
+        std::function<void(double)> render;
+
+        // Called once per frame after the buffer swap
+        std::function<void()> idle;
+    };
+
+    /**
+     * @brief A fixed-timestep main loop for the window
+     *
+     * See MainLoopCreateInfo for a description of a frame. Only call
+     * run() from the main thread after Window::create().
+     */
+    class MainLoop
+    {
+    public:
+        /**
+         * @brief Run frames until the window is closed or stop() is called
+         *
+         * @throw std::runtime_error if the window has not been created or
+         *                           the loop is already running
+         */
+        static void run(const MainLoopCreateInfo& info);
+
+        /**
+         * @brief Stop the loop after the current frame
+         *
+         * Thread safe.
+         */
+        static void stop() noexcept;
+
+        [[nodiscard]]
+        static bool isRunning() noexcept {
+            return running;
+        }
+
+        /**
+         * @return uint64_t Number of updates since run() was called
+         */
+        [[nodiscard]]
+        static auto getTickCount() noexcept -> uint64_t {
+            return tickCount;
+        }
+
+        /**
+         * @return Clock::duration Time that has been dropped because a
+         *                         frame was too slow, since run() was
+         *                         called
+         */
+        [[nodiscard]]
+        static auto getDroppedTime() noexcept -> Clock::duration {
+            return droppedTime;
+        }
+
+    private:
+        static inline bool running{ false };
+        static inline std::atomic<bool> stopRequested{ false };
+
+        static inline uint64_t tickCount{ 0 };
+        static inline Clock::duration droppedTime{ 0 };
+    };
+} // namespace glb
+
+#endif
@@ -30,6 +30,9 @@ The contained OpenGL objects will only be destroyed when no references to them (
 
 glUnique*-objects can only be moved, ensuring that only a single owner exists at any time.
 
+glSharedSync and glUniqueSync manage GLsync fence objects. Their handle is a pointer, so "no object" is
+nullptr instead of 0.
+
 
 --- Example:
 
@@ -140,10 +143,28 @@ public:
 	}
 };
 
+struct _query_deleter
+{
+public:
+	void operator()(GLuint* handle) const noexcept {
+		glDeleteQueries(1, handle);
+		delete handle;
+	}
+};
+
+struct _sync_deleter
+{
+public:
+	void operator()(GLsync* handle) const noexcept {
+		glDeleteSync(*handle);
+		delete handle;
+	}
+};
+
 
 
 // SHARED RESOURCE
-template<class _Del>
+template<class _Del, typename _Handle = GLuint>
 class _gl_shared_resource
 {
 public:
@@ -157,37 +178,37 @@ public:
 	_gl_shared_resource& operator=(_gl_shared_resource&&) noexcept = default;
 
 	// Takes the resource handle that will be managed.
-	explicit _gl_shared_resource(GLuint handle)
+	explicit _gl_shared_resource(_Handle handle)
 		:
-		_handle(std::shared_ptr<GLuint>(new GLuint(handle), _Del()))
+		_handle(std::shared_ptr<_Handle>(new _Handle(handle), _Del()))
 	{
 	}
 
-	// Assignment operator from GLuint
-	inline auto operator=(GLuint rhs) noexcept -> _gl_shared_resource& {
-		_handle = std::shared_ptr<GLuint>(new GLuint(rhs), _Del());
+	// Assignment operator from a resource handle
+	inline auto operator=(_Handle rhs) noexcept -> _gl_shared_resource& {
+		_handle = std::shared_ptr<_Handle>(new _Handle(rhs), _Del());
 		return *this;
 	}
 
 	// The natural-feeling address operator
 	[[nodiscard]]
-	inline auto operator&() const noexcept -> GLuint* {
+	inline auto operator&() const noexcept -> _Handle* {
 		return _handle.get();
 	}
 
 	// The natural value-access operator
 	[[nodiscard]]
-	inline auto operator*() const noexcept -> GLuint {
+	inline auto operator*() const noexcept -> _Handle {
 		return *_handle;
 	}
 
 	// Releases the contained object. Deletes the object if this is the last reference to it.
 	inline void release() noexcept {
-		_handle.reset(new GLuint(0), _Del());
+		_handle.reset(new _Handle{}, _Del());
 	}
 
 	// Releases the contained object. Returns an assignable pointer to the object handle.
-	inline auto assign() noexcept -> GLuint* {
+	inline auto assign() noexcept -> _Handle* {
 		release();
 		return _handle.get();
 	}
@@ -198,17 +219,17 @@ public:
 	}
 
 private:
-	std::shared_ptr<GLuint> _handle{ new GLuint{0}, _Del() };
+	std::shared_ptr<_Handle> _handle{ new _Handle{}, _Del() };
 };
 
 
 
 // UNIQUE RESOURCE
-template<class _Del>
+template<class _Del, typename _Handle = GLuint>
 class _gl_unique_resource
 {
 public:
-	using _gl_deleter_func = std::function<void(GLuint*)>;
+	using _gl_deleter_func = std::function<void(_Handle*)>;
 
 	// Default constructor, initializes buffer handle to 0.
 	_gl_unique_resource() = default;
@@ -220,35 +241,35 @@ public:
 	_gl_unique_resource& operator=(_gl_unique_resource&&) noexcept = default;
 
 	// Takes the resource handle that will be managed.
-	explicit _gl_unique_resource(GLuint handle)
+	explicit _gl_unique_resource(_Handle handle)
 		:
-		_handle(std::unique_ptr<GLuint, _gl_deleter_func>(new GLuint(handle), _Del()))
+		_handle(std::unique_ptr<_Handle, _gl_deleter_func>(new _Handle(handle), _Del()))
 	{
 	}
 
-	// Assignment operator from GLuint
-	inline auto operator=(GLuint rhs) noexcept -> _gl_unique_resource& {
-		_handle = std::unique_ptr<GLuint, _gl_deleter_func>(new GLuint(rhs), _Del());
+	// Assignment operator from a resource handle
+	inline auto operator=(_Handle rhs) noexcept -> _gl_unique_resource& {
+		_handle = std::unique_ptr<_Handle, _gl_deleter_func>(new _Handle(rhs), _Del());
 		return *this;
 	}
 
 	// The natural-feeling address operator
-	inline auto operator&() const noexcept -> GLuint* {
+	inline auto operator&() const noexcept -> _Handle* {
 		return _handle.get();
 	}
 
 	// The natural value-access operator
-	inline auto operator*() const noexcept -> GLuint {
+	inline auto operator*() const noexcept -> _Handle {
 		return *_handle;
 	}
 
 	// Deletes the contained object.
 	inline void release() noexcept {
-		_handle.reset(new GLuint(0));
+		_handle.reset(new _Handle{});
 	}
 
 	// Deletes the contained object. Returns an assignable pointer to the object handle.
-	inline auto assign() noexcept -> GLuint* {
+	inline auto assign() noexcept -> _Handle* {
 		release();
 		return _handle.get();
 	}
@@ -258,7 +279,7 @@ public:
 	}
 
 private:
-	std::unique_ptr<GLuint, _gl_deleter_func> _handle{ new GLuint{0}, _Del() };
+	std::unique_ptr<_Handle, _gl_deleter_func> _handle{ new _Handle{}, _Del() };
 };
 
 
@@ -269,6 +290,8 @@ using glSharedTransformFeedback = _gl_shared_resource<_transform_feedback_delete
 using glSharedFramebuffer		= _gl_shared_resource<_framebuffer_deleter>;
 using glSharedRenderbuffer		= _gl_shared_resource<_renderbuffer_deleter>;
 using glSharedProgram			= _gl_shared_resource<_program_deleter>;
+using glSharedQuery				= _gl_shared_resource<_query_deleter>;
+using glSharedSync				= _gl_shared_resource<_sync_deleter, GLsync>;
 
 using glUniqueBuffer			= _gl_unique_resource<_buffer_deleter>;
 using glUniqueTexture			= _gl_unique_resource<_texture_deleter>;
@@ -277,5 +300,7 @@ using glUniqueTransformFeedback = _gl_unique_resource<_transform_feedback_delete
 using glUniqueFramebuffer		= _gl_unique_resource<_framebuffer_deleter>;
 using glUniqueRenderbuffer		= _gl_unique_resource<_renderbuffer_deleter>;
 using glUniqueProgram			= _gl_unique_resource<_program_deleter>;
+using glUniqueQuery				= _gl_unique_resource<_query_deleter>;
+using glUniqueSync				= _gl_unique_resource<_sync_deleter, GLsync>;
 
 #endif
\ No newline at end of file
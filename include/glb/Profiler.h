@@ -0,0 +1,146 @@
+#pragma once
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "Clock.h"
+
+namespace glb
+{
+    class ProfileZone;
+
+    constexpr size_t DEFAULT_PROFILER_EVENTS_PER_THREAD = 1 << 20;
+
+    /**
+     * @brief Records the CPU time of named, nested zones on all threads
+     *
+     * Use the GLB_PROFILE_ZONE macro to time a scope:
+     *
+     *      void foo()
+     *      {
+     *          GLB_PROFILE_ZONE("foo");
+     *          ...
+     *      }
+     *
+     * Every thread records into its own buffer, so recording a zone takes
+     * no lock and touches no memory that other threads write to. Buffers
+     * grow in fixed-size chunks and are kept after their thread has
+     * exited, so a trace can be written at any time. Each thread records
+     * at most the configured number of zones; further zones are dropped
+     * and counted.
+     *
+     * The recorded zones can be written as a Chrome trace (JSON), which
+     * can be opened in chrome://tracing or Perfetto.
+     *
+     * Disabled by default. While disabled, zones cost a single flag check.
+     * Define GLB_DISABLE_PROFILER to compile the macros away entirely.
+     */
+    class Profiler
+    {
+    public:
+        static void setEnabled(bool enabled) noexcept;
+
+        [[nodiscard]]
+        static bool isEnabled() noexcept {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Set the maximum number of zones recorded per thread
+         *
+         * Only affects threads that start recording afterwards and
+         * buffers that have been cleared.
+         */
+        static void setMaxEventsPerThread(size_t count) noexcept;
+
+        /**
+         * @brief Set the name of the calling thread in the trace
+         */
+        static void setThreadName(std::string name);
+
+        /**
+         * @return uint64_t Number of zones that were not recorded because
+         *                  a thread's buffer was full
+         */
+        [[nodiscard]]
+        static auto getDroppedEventCount() noexcept -> uint64_t;
+
+        /**
+         * @brief Discard all recorded zones
+         *
+         * Must not be called while other threads record zones.
+         */
+        static void clear();
+
+        /**
+         * @brief Write all recorded zones as a Chrome trace
+         *
+         * May be called while other threads record zones. Zones that end
+         * after the call has begun may be missing from the trace.
+         *
+         * @throw std::runtime_error if the file cannot be opened
+         */
+        static void writeChromeTrace(const fs::path& file);
+
+    private:
+        friend ProfileZone;
+
+        // Called by ProfileZone when the zone ends. The name must stay
+        // valid until the trace has been written.
+        static void record(const char* name, Clock::time_point begin, Clock::time_point end);
+
+        static inline std::atomic<bool> enabled{ false };
+        static inline std::atomic<size_t> maxEventsPerThread{ DEFAULT_PROFILER_EVENTS_PER_THREAD };
+        static inline std::atomic<uint64_t> droppedEventCount{ 0 };
+    };
+
+    /**
+     * @brief Records the time of a scope with the Profiler
+     *
+     * The name must be a string literal or otherwise outlive the profiler,
+     * because only the pointer is stored.
+     */
+    class ProfileZone
+    {
+    public:
+        explicit ProfileZone(const char* name) noexcept
+            : name(Profiler::isEnabled() ? name : nullptr)
+        {
+            if (this->name != nullptr) {
+                begin = Clock::now();
+            }
+        }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone(ProfileZone&&) noexcept = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+        ProfileZone& operator=(ProfileZone&&) noexcept = delete;
+
+        ~ProfileZone() {
+            if (name != nullptr) {
+                Profiler::record(name, begin, Clock::now());
+            }
+        }
+
+    private:
+        const char* name;
+        Clock::time_point begin;
+    };
+} // namespace glb
+
+#define GLB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define GLB_PROFILE_CONCAT(a, b) GLB_PROFILE_CONCAT_IMPL(a, b)
+
+#ifndef GLB_DISABLE_PROFILER
+    #define GLB_PROFILE_ZONE(name) \
+        ::glb::ProfileZone GLB_PROFILE_CONCAT(_glbProfileZone, __LINE__)(name)
+#else
+    #define GLB_PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+namespace glb
+{
+    /**
+     * @brief A work-stealing thread pool
+     *
+     * Every worker thread owns a task queue. Tasks submitted from a worker
+     * go to that worker's own queue and are taken in LIFO order, which
+     * keeps their data in the worker's cache. Tasks submitted from other
+     * threads are distributed round-robin. Idle workers steal the oldest
+     * task from other workers' queues before they go to sleep.
+     *
+     * Tasks that block only occupy their own worker; the remaining workers
+     * steal the blocked worker's queued tasks.
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param uint32_t threadCount Number of worker threads. Zero uses
+         *                             one thread per hardware thread.
+         */
+        explicit ThreadPool(uint32_t threadCount = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+        /**
+         * @brief Runs all remaining tasks, then joins the worker threads
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Schedule a task for execution on a worker thread
+         *
+         * Thread safe.
+         */
+        void submit(std::function<void()> task);
+
+        [[nodiscard]]
+        auto getThreadCount() const noexcept -> uint32_t;
+
+        /**
+         * @return bool True if the calling thread is one of this pool's
+         *              worker threads
+         */
+        [[nodiscard]]
+        bool isWorkerThread() const noexcept;
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        void work(uint32_t index);
+        bool tryPop(uint32_t index, std::function<void()>& result);
+        bool trySteal(uint32_t thief, std::function<void()>& result);
+
+        std::vector<std::unique_ptr<WorkQueue>> queues;
+        std::vector<std::thread> threads;
+
+        std::atomic<uint32_t> nextQueue{ 0 };
+        std::atomic<size_t> pendingTasks{ 0 };
+        std::atomic<uint32_t> sleepingWorkers{ 0 };
+        std::atomic<bool> stopRequested{ false };
+        std::mutex sleepLock;
+        std::condition_variable wakeCondition;
+
+        // The pool and queue index of the current worker thread
+        static inline thread_local ThreadPool* currentPool{ nullptr };
+        static inline thread_local uint32_t currentQueue{ 0 };
+    };
+} // namespace glb
+
+#endif
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include <chrono>
 
+#include "Clock.h"
+
 namespace glb
 {
     using DefaultTimeType = std::chrono::milliseconds;
 
     /**
      * Counts elapsed time
+     *
+     * Measures with glb::Clock, so the result is never negative and does
+     * not jump when the system time changes. The start time is kept at
+     * the clock's full resolution; TimeType only selects the unit of the
+     * returned counts. Use elapsed() for a nanosecond-resolution duration.
      */
     template<typename TimeType = DefaultTimeType>
     class Timer
@@ -15,15 +23,32 @@ namespace glb
     public:
         Timer();
 
-        auto reset() noexcept -> uint32_t;
-        auto duration() const noexcept -> uint32_t;
+        /**
+         * @brief Restart the timer
+         *
+         * @return uint64_t Time since the last reset in TimeType units
+         */
+        auto reset() noexcept -> uint64_t;
+
+        /**
+         * @return uint64_t Time since the last reset in TimeType units
+         */
+        auto duration() const noexcept -> uint64_t;
+
+        /**
+         * @return Clock::duration Time since the last reset at the full
+         *                         resolution of the clock
+         */
+        auto elapsed() const noexcept -> Clock::duration;
 
     private:
-        using ClockType = std::chrono::system_clock;
-        using TimePoint = std::chrono::time_point<ClockType, TimeType>;
+        using ClockType = Clock;
+        using TimePoint = ClockType::time_point;
 
         TimePoint last_reset;
     };
 
+    using NanosecondTimer = Timer<std::chrono::nanoseconds>;
+
 #include "Timer.inl"
 } // namespace glb
@@ -4,6 +4,8 @@
 
 #include <vector>
 #include <string>
+#include <filesystem>
+namespace fs = std::filesystem;
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -11,6 +13,9 @@
 using namespace glm;
 
 #include "event/Event.h"
+#include "event/EventHandler.h"
+#include "Clock.h"
+#include "OpenglResource.h"
 
 namespace glb
 {
@@ -22,7 +27,23 @@ namespace glb
     constexpr int DEFAULT_OPENGL_SAMPLE_COUNT = 4;
 
     constexpr int SWAP_INTERVAL_VSYNC_DISABLED = 0;
-    constexpr int SWAP_INTERVAL_VSYNC_ENABLED = 2;
+    constexpr int SWAP_INTERVAL_VSYNC_ENABLED = 1;
+
+    constexpr uint32_t DEFAULT_MAX_FRAMES_IN_FLIGHT = 2;
+    constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+
+    /**
+     * @brief The duration of one phase of Window::create()
+     */
+    struct StartupPhaseTiming
+    {
+        std::string name;
+        Clock::duration duration{ 0 };
+
+        // True if the phase ran on a background thread while the OpenGL
+        // context was created
+        bool background{ false };
+    };
 
     /**
      * @brief A window. Represents an OpenGL rendering context.
@@ -41,6 +62,10 @@ namespace glb
      * been destroyed.
      * Query whether the window is created with Window::isOpen().
      *
+     * Set WindowCreateInfo::headless to create an offscreen context on
+     * machines without a display, for example to run render benchmarks on
+     * CI hosts.
+     *
      * The WindowCreateInfo structure is passed as an argument to Window::create()
      * and controls many properties of the window and further functionality
      * of the library.
@@ -88,7 +113,11 @@ namespace glb
          *
          * glb always tries to initialize the context with the highest
          * possible OpenGL version. If context creation fails, it will try
-         * out lower version until context creation succeeds.
+         * out lower version until context creation succeeds. The version
+         * and context creation API that succeeded are cached, so creating
+         * the window again only tries that combination. Everything else
+         * is only probed again if it fails. Set contextVersionCacheFile to
+         * keep the cache across launches.
          *
          * It is possible to specify a minimum number for major and minor
          * versions. If these minimums cannot be met, window creation will
@@ -122,6 +151,28 @@ namespace glb
             bool fullscreen{ false };
             bool vsync{ false };
 
+            // Limit the frame rate to this many frames per second with the
+            // FrameLimiter. Zero doesn't limit the frame rate.
+            double maxFrameRate{ 0.0 };
+
+            // The number of frames that the GPU may lag behind the CPU.
+            // See Window::setMaxFramesInFlight().
+            uint32_t maxFramesInFlight{ DEFAULT_MAX_FRAMES_IN_FLIGHT };
+
+            // Don't show a window. Creates an offscreen OpenGL context
+            // through OSMesa, or through EGL if OSMesa is not available.
+            // Mesa's software rasterizer llvmpipe works. The default
+            // framebuffer is an offscreen buffer of the requested size
+            // that can be read back with glReadPixels(). Everything else
+            // works as with a visible window, but no input events are
+            // generated.
+            //
+            // GLFW 3.4 and later don't need a display server in this
+            // mode. Older versions still connect to one to create a hidden
+            // window. The window system is chosen by the first call to
+            // Window::create().
+            bool headless{ false };
+
             // A combination of InputModeFlags that control input behaviour
             InputModeFlags inputMode = static_cast<InputModeFlags>(
                 InputModeFlags::stickyKeys | InputModeFlags::stickyMouseButtons
@@ -129,9 +180,46 @@ namespace glb
             // A CursorMode that controls cursor behaviour
             CursorMode cursorMode{ CursorMode::normal };
 
+            // Use unscaled and unaccelerated mouse motion while the cursor
+            // is disabled, if the platform supports it. Recommended for
+            // camera control.
+            bool rawMouseMotion{ true };
+
+            // While the cursor is disabled, don't generate a MouseMoveEvent
+            // for every cursor sample. The motion is still reported once
+            // per pollEvents() by a MouseMotionEvent and the InputState
+            // snapshot. Avoids flooding the event queue with high polling
+            // rate mice.
+            bool accumulateMouseMotion{ false };
+
             // Start an event handler thread if true. Setting this to false
             // disabled the event handler and thus the glb event system.
             bool useEventHandler{ true };
+
+            // Configuration of the event handler thread. Ignored if
+            // useEventHandler is false.
+            EventHandler::EventHandlerCreateInfo eventHandlerInfo;
+
+            // Files that are read into the FileCache on a background
+            // thread while the OpenGL context is created. List the shaders
+            // and textures that are loaded right after window creation.
+            std::vector<fs::path> prefetchFiles;
+
+            // File that stores the OpenGL version and context creation API
+            // a context could be created with. Later launches try only
+            // that combination first instead of probing every version.
+            // Empty doesn't use a file. Delete the file after a driver
+            // update to probe all versions again.
+            fs::path contextVersionCacheFile;
+
+            // Merge consecutive pending MouseMoveEvents into one event with
+            // the latest cursor position. Useful with high polling rate
+            // mice. See EventHandler::setCoalescing().
+            bool coalesceMouseMoveEvents{ false };
+
+            // Merge consecutive pending MouseScrollEvents into one event
+            // with the summed scroll offset.
+            bool coalesceMouseScrollEvents{ false };
         };
 
         /**
@@ -142,6 +230,12 @@ namespace glb
          *
          * Generates a WindowCreateEvent.
          *
+         * DevIL initialization, WindowCreateInfo::prefetchFiles and the
+         * prepare functions of lazy initializers run on background
+         * threads while the OpenGL context is created. The duration of
+         * every phase is printed and can be queried with
+         * getStartupTimings().
+         *
          * @param WindowData data Initialization data
          */
         static void create(const WindowCreateInfo& data = {});
@@ -149,7 +243,9 @@ namespace glb
         /**
          * @brief Close and destroy the window
          *
-         * Generates a WindowCloseEvent.
+         * Generates a WindowCloseEvent. Stops the event handler thread
+         * after all pending events have been dispatched. Discards all
+         * prefetched files that have not been taken from the FileCache.
          *
          * Does nothing if the window has already been destroyed
          */
@@ -167,14 +263,63 @@ namespace glb
          * Call this after a frame has been rendered. Swaps front- and back
          * buffer. That means that all rendered framebuffer contents will be
          * shown on the screen.
+         *
+         * Inserts a fence after the swap and waits until no more than the
+         * maximum number of frames are in flight. Then waits for the
+         * FrameLimiter if a maximum frame rate is set. Records the frame's
+         * timing in FrameStatistics and reads back finished GpuProfiler
+         * queries. Records the frame latency of dispatched events if the
+         * LatencyTracker is enabled.
          */
         static void swapBuffers();
 
+        /**
+         * @brief Limit how far the CPU may run ahead of the GPU
+         *
+         * Without a limit, the driver queues frames freely, which adds
+         * input latency and can stall unpredictably in the buffer swap.
+         * With a limit, swapBuffers() waits on a fence until the GPU has
+         * finished all but the given number of frames, including the one
+         * that was just swapped. One frame in flight never lets the CPU
+         * start a new frame before the GPU has finished the previous
+         * one. Two let the CPU work on a frame while the GPU renders the
+         * previous one.
+         *
+         * The time spent waiting is recorded in FrameTiming::fenceWaitTime.
+         *
+         * Only call this from the main thread.
+         *
+         * The limit is always disabled if the OpenGL context supports
+         * neither OpenGL 3.2 nor ARB_sync.
+         *
+         * @param uint32_t frames Between 1 and MAX_FRAMES_IN_FLIGHT. Zero
+         *                        disables the limit.
+         *
+         * @throw std::runtime_error if frames is larger than
+         *                           MAX_FRAMES_IN_FLIGHT
+         */
+        static void setMaxFramesInFlight(uint32_t frames);
+
+        /**
+         * @return uint32_t The maximum number of frames in flight. Zero if
+         *                  not limited.
+         */
+        static auto getMaxFramesInFlight() -> uint32_t;
+
         /**
          * @brief Dispatch events
          *
          * Call this once per frame.
          * Only call this from the main thread.
+         *
+         * Publishes a new InputState snapshot after the window system's
+         * events have been processed. If the cursor is disabled and has
+         * been moved, generates a single MouseMotionEvent with the motion
+         * accumulated since the last call.
+         *
+         * If the event handler runs in EventDispatchMode::synchronous, all
+         * pending events are delivered to listeners on the calling thread
+         * before this function returns.
          */
         static void pollEvents();
 
@@ -222,17 +367,43 @@ namespace glb
          */
         static bool isContextCreated();
 
+        /**
+         * @return bool True if the window has been created with
+         *              WindowCreateInfo::headless
+         */
+        static bool isHeadless();
+
+        /**
+         * @return std::vector<StartupPhaseTiming> The phases of the last
+         *                                         call to create() that
+         *                                         created a window, in
+         *                                         order. The last entry is
+         *                                         the total.
+         */
+        static auto getStartupTimings() -> std::vector<StartupPhaseTiming>;
+
     private:
         // Internal GLFW callbacks
         static void initCallbacks();
 
         static void makeContextCurrent();
+        static auto waitForFramesInFlight() -> Clock::duration;
         static inline bool contextCreated{ false };
 
         static inline GLFWwindow* window{ nullptr };
         static inline ivec2 sizePixels;
         static inline bool _isOpen{ false };
         static inline bool _isFullscreen{ false };
+        static inline bool headless{ false };
+        static inline bool cursorDisabled{ false };
+        static inline bool accumulateMouseMotion{ false };
+
+        // Fences after the frames in flight, the oldest first
+        static inline uint32_t maxFramesInFlight{ DEFAULT_MAX_FRAMES_IN_FLIGHT };
+        static inline bool fencesSupported{ true };
+        static inline std::vector<glUniqueSync> frameFences;
+
+        static inline std::vector<StartupPhaseTiming> startupTimings;
     };
 
 
@@ -0,0 +1,170 @@
+#pragma once
+#ifndef ACTIONMAP_H
+#define ACTIONMAP_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Event.h"
+#include "EventBatch.h"
+#include "InputEvents.h"
+#include "KeyDefinitions.h"
+
+namespace glb
+{
+    /**
+     * @brief An application-defined action, e.g. "jump" or "move forward"
+     *
+     * Action ids are dense, starting at zero, so they can index arrays.
+     */
+    using ActionId = uint32_t;
+
+    constexpr ActionId NO_ACTION = UINT32_MAX;
+
+    /**
+     * @brief Binds a key with an exact combination of modifiers to an action
+     *
+     * Only shift, control, alt and super are considered. Caps lock and
+     * num lock are ignored.
+     */
+    struct KeyBinding
+    {
+        eKey key;
+        int mods;
+        ActionId action;
+    };
+
+    /**
+     * @brief Maps key events to actions
+     *
+     * The bindings are compiled into a flat table indexed by key and
+     * modifiers, so resolving a key event is a single array lookup.
+     * Changing the bindings rebuilds the table.
+     *
+     * The state of all actions is kept in dense arrays with one byte per
+     * action, which per-frame systems can scan (and vectorize) directly:
+     *
+     *      const uint8_t* active = actions.getActiveStates();
+     *      for (ActionId i = 0; i < actions.getActionCount(); i++) {
+     *          velocity += active[i] * actionVelocities[i];
+     *      }
+     *
+     * An action stays active while any key that triggered it is held. A
+     * key that is released deactivates the action it activated, even if
+     * the modifiers have changed in the meantime.
+     *
+     * Not thread safe. Feed it events from a single listener and read the
+     * state on the same thread, or synchronize externally.
+     */
+    class ActionMap
+    {
+    public:
+        explicit ActionMap(uint32_t actionCount);
+
+        /**
+         * @brief Add a binding
+         *
+         * Replaces an existing binding of the same key and modifiers.
+         */
+        void bind(eKey key, int mods, ActionId action);
+
+        /**
+         * @brief Remove the binding of a key and modifiers, if any
+         */
+        void unbind(eKey key, int mods);
+
+        /**
+         * @brief Replace all bindings at once
+         */
+        void setBindings(std::vector<KeyBinding> bindings);
+
+        [[nodiscard]]
+        auto getBindings() const noexcept -> const std::vector<KeyBinding>&;
+
+        /**
+         * @return ActionId The action bound to the key and modifiers.
+         *                  NO_ACTION if there is none.
+         */
+        [[nodiscard]]
+        auto resolve(eKey key, int mods) const noexcept -> ActionId;
+
+        /**
+         * @brief Update the action states from an event
+         *
+         * Ignores all events except KeyPressEvents and KeyReleaseEvents.
+         */
+        void handleEvent(const Event& event);
+        void handleEvents(const EventBatch& events);
+
+        /**
+         * @brief Clear the pressed and released states
+         *
+         * Call this once per frame after the states have been read.
+         */
+        void clearTransitions() noexcept;
+
+        [[nodiscard]]
+        auto getActionCount() const noexcept -> uint32_t;
+
+        [[nodiscard]]
+        bool isActive(ActionId action) const noexcept;
+
+        [[nodiscard]]
+        bool wasPressed(ActionId action) const noexcept;
+
+        [[nodiscard]]
+        bool wasReleased(ActionId action) const noexcept;
+
+        /**
+         * @return const uint8_t* One byte per action, 1 while the action is
+         *                        active, 0 otherwise
+         */
+        [[nodiscard]]
+        auto getActiveStates() const noexcept -> const uint8_t*;
+
+        /**
+         * @return const uint8_t* One byte per action, 1 if the action has
+         *                        been activated since the last call to
+         *                        clearTransitions(), 0 otherwise
+         */
+        [[nodiscard]]
+        auto getPressedStates() const noexcept -> const uint8_t*;
+
+        /**
+         * @return const uint8_t* One byte per action, 1 if the action has
+         *                        been deactivated since the last call to
+         *                        clearTransitions(), 0 otherwise
+         */
+        [[nodiscard]]
+        auto getReleasedStates() const noexcept -> const uint8_t*;
+
+    private:
+        static constexpr uint32_t KEY_COUNT = static_cast<uint32_t>(eKey::MAX_ENUM) + 1;
+        static constexpr int MOD_MASK = shift | control | alt | super;
+        static constexpr uint32_t MOD_COMBINATIONS = MOD_MASK + 1;
+
+        static auto getTableIndex(eKey key, int mods) noexcept -> uint32_t;
+
+        void rebuildTable();
+        void press(eKey key, int mods);
+        void release(eKey key);
+
+        uint32_t actionCount;
+        std::vector<KeyBinding> bindings;
+
+        // [key][mods]
+        std::vector<ActionId> table;
+
+        // The action that each held key has activated
+        std::vector<ActionId> keyActions;
+
+        // Number of held keys per action
+        std::vector<uint16_t> activeKeyCount;
+
+        std::vector<uint8_t> active;
+        std::vector<uint8_t> pressed;
+        std::vector<uint8_t> released;
+    };
+} // namespace glb
+
+#endif
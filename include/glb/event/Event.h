@@ -2,10 +2,71 @@
 #ifndef EVENT_H
 #define EVENT_H
 
+#include <cstdint>
+#include <atomic>
+#include <typeinfo>
 #include <type_traits>
 
+#include "../Clock.h"
+
 namespace glb
 {
+    class Event;
+    class EventHandler;
+
+    /**
+     * @brief A dense, process-wide unique number for each event type
+     */
+    using EventTypeId = uint32_t;
+
+    constexpr EventTypeId INVALID_EVENT_TYPE_ID = UINT32_MAX;
+
+    namespace internal
+    {
+        inline std::atomic<EventTypeId> nextEventTypeId{ 0 };
+
+        // Names of the types with the lowest ids
+        constexpr EventTypeId MAX_NAMED_EVENT_TYPES = 256;
+        inline std::atomic<const char*> eventTypeNames[MAX_NAMED_EVENT_TYPES]{};
+    }
+
+    /**
+     * @brief Get the type id of an event type
+     *
+     * Ids are assigned on first use and are dense, so they can be used
+     * to index arrays. They are not stable across program runs.
+     *
+     * @tparam T The event type. Must be derived from Event.
+     */
+    template<class T>
+    inline auto getEventTypeId() noexcept -> EventTypeId
+    {
+        static_assert(std::is_base_of_v<Event, T>, "glb::getEventTypeId<> template parameter must be derived from glb::Event");
+        static_assert(std::is_same_v<std::decay_t<T>, T>, "glb::getEventTypeId<> template parameter must be a decayed type");
+
+        static const EventTypeId id = []() {
+            const EventTypeId newId = internal::nextEventTypeId++;
+            if (newId < internal::MAX_NAMED_EVENT_TYPES) {
+                internal::eventTypeNames[newId].store(typeid(T).name(), std::memory_order_release);
+            }
+            return newId;
+        }();
+        return id;
+    }
+
+    /**
+     * @brief Get the name of the type that an id has been assigned to
+     *
+     * @return const char* The implementation-defined name of the type as
+     *                     returned by std::type_info::name(). nullptr if
+     *                     the id has not been assigned or is too high.
+     */
+    inline auto getEventTypeName(EventTypeId id) noexcept -> const char*
+    {
+        if (id >= internal::MAX_NAMED_EVENT_TYPES) return nullptr;
+        return internal::eventTypeNames[id].load(std::memory_order_acquire);
+    }
+
     /**
      * @brief The base class for all events
      *
@@ -13,15 +74,18 @@ namespace glb
      * know which event you're dealing with. Events are differentiated by
      * their type. Use Event::is() and event::to() to test and cast events.
      *
+     * Both use dynamic_cast. If you are only interested in specific event
+     * types, prefer EventHandler::subscribe(), which doesn't need RTTI.
+     *
      * Example:
      *
-     *      if (event->is<MouseEvent>())
+     *      if (event.is<MouseEvent>())
      *      {
      *          // handle mouse event
      *      }
-     *      else if (event->is<WindowEvent>())
+     *      else if (event.is<WindowEvent>())
      *      {
-     *          auto e = event->to<WindowEvent>();
+     *          auto e = event.to<WindowEvent>();
      *          // handle window event
      *      }
      */
@@ -34,7 +98,7 @@ namespace glb
         template<typename T>
         static constexpr bool isDecayed = std::is_same_v<std::decay_t<T>, T>;
 
-        Event() noexcept = default;
+        Event() noexcept : timestamp(Clock::now()) {}
         Event(const Event&) = default;
         Event(Event&&) noexcept = default;
         virtual ~Event() = default;
@@ -42,6 +106,27 @@ namespace glb
         Event& operator=(const Event&) = default;
         Event& operator=(Event&&) noexcept = default;
 
+        /**
+         * @return EventTypeId The type id of the static type the event had
+         *                     when it was passed to EventHandler::notify().
+         *                     INVALID_EVENT_TYPE_ID if the event has not
+         *                     been passed to the event handler.
+         */
+        [[nodiscard]]
+        auto getTypeId() const noexcept -> EventTypeId {
+            return typeId;
+        }
+
+        /**
+         * @return Clock::time_point The time at which the event was created.
+         *                           For input events, this is the time of
+         *                           the window system callback.
+         */
+        [[nodiscard]]
+        auto getTimestamp() const noexcept -> Clock::time_point {
+            return timestamp;
+        }
+
         /**
          * @brief Check whether the event is of a specific type
          *
@@ -97,12 +182,18 @@ namespace glb
          * @return A pointer if the cast was successful, nullptr otherwise
          */
         template<class T> [[nodiscard]]
-        T* to() const noexcept {
+        const T* to() const noexcept {
             static_assert(isEventType<T>, "glb::Event::to<> template parameter must be derived from glb::Event");
             static_assert(isDecayed<T>, "glb::Event::to<> template parameter must be a decayed type");
 
             return dynamic_cast<const T*>(this);
         }
+
+    private:
+        friend EventHandler;
+
+        EventTypeId typeId{ INVALID_EVENT_TYPE_ID };
+        Clock::time_point timestamp;
     };
 } // namespace glb
 
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef EVENTBATCH_H
+#define EVENTBATCH_H
+
+#include <cstddef>
+
+#include "Event.h"
+
+namespace glb
+{
+    /**
+     * @brief A contiguous, read-only view of several events
+     *
+     * Passed to Listener::onEvents(). Contains all events that were
+     * dispatched together, in the order in which they were notified.
+     *
+     * The events are only valid for the duration of the call that the
+     * batch has been passed to.
+     *
+     * Example:
+     *
+     *      void onEvents(const EventBatch& events) override
+     *      {
+     *          for (const Event* e : events)
+     *          {
+     *              if (e->getTypeId() == getEventTypeId<KeyPressEvent>()) {
+     *                  // ...
+     *              }
+     *          }
+     *      }
+     */
+    class EventBatch
+    {
+    public:
+        using const_iterator = const Event* const*;
+
+        EventBatch(const Event* const* events, size_t count) noexcept
+            : events(events), count(count) {}
+
+        [[nodiscard]]
+        auto begin() const noexcept -> const_iterator {
+            return events;
+        }
+
+        [[nodiscard]]
+        auto end() const noexcept -> const_iterator {
+            return events + count;
+        }
+
+        [[nodiscard]]
+        auto operator[](size_t index) const noexcept -> const Event& {
+            return *events[index];
+        }
+
+        [[nodiscard]]
+        auto size() const noexcept -> size_t {
+            return count;
+        }
+
+        [[nodiscard]]
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+    private:
+        const Event* const* events;
+        size_t count;
+    };
+} // namespace glb
+
+#endif
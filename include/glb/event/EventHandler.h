@@ -2,35 +2,792 @@
 #ifndef EVENTHANDLER_H
 #define EVENTHANDLER_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
-#include <queue>
+#include <functional>
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <type_traits>
 
 #include "Event.h"
+#include "EventBatch.h"
 #include "InputEvents.h"
+#include "InputRecording.h"
+#include "LatencyTracker.h"
+#include "RingBuffer.h"
+#include "StoredEvent.h"
+#include "TimerWheel.h"
+#include "../ThreadPool.h"
 
 namespace glb
 {
     class Listener;
+    class EventExecutor;
+
+    constexpr size_t DEFAULT_EVENT_QUEUE_CAPACITY = 4096;
+    constexpr size_t DEFAULT_EXECUTOR_QUEUE_CAPACITY = 256;
+    constexpr uint32_t DEFAULT_DISPATCHER_SPIN_COUNT = 2000;
+
+    /**
+     * @brief Controls on which thread listeners are called
+     */
+    enum class EventDispatchMode
+    {
+        // Events are dispatched on a dedicated event handler thread as
+        // soon as they arrive. Listeners must synchronize everything they
+        // share with other threads.
+        asynchronous,
+
+        // Events are queued until EventHandler::dispatchEvents() is called
+        // and are dispatched on the calling thread. Window::pollEvents()
+        // does this, so listeners run on the OpenGL thread in a
+        // deterministic order and may issue OpenGL calls.
+        synchronous,
+
+        // Like asynchronous, but listeners are called concurrently on a
+        // work-stealing thread pool. Every listener still sees all events
+        // in order, one batch after another. A slow or blocking listener
+        // only delays itself. See ListenerDispatchInfo.
+        parallel,
+    };
+
+    /**
+     * @brief Where a listener is called in EventDispatchMode::parallel
+     *
+     * Ignored in all other dispatch modes.
+     */
+    enum class ListenerAffinity
+    {
+        // On the event handler's thread pool
+        pool,
+
+        // On the event handler thread, one after another in registration
+        // order, while the pool processes the same batch. Use this for
+        // listeners that are cheap or must not run concurrently with
+        // subscribed callbacks.
+        dispatcher,
+    };
+
+    /**
+     * @brief Dispatch constraints of a listener
+     *
+     * Passed to the Listener constructor. Affinity and serial group are
+     * only relevant in EventDispatchMode::parallel.
+     */
+    struct ListenerDispatchInfo
+    {
+        ListenerAffinity affinity{ ListenerAffinity::pool };
+
+        // Listeners on the pool that share the same non-zero group are
+        // called one after another in registration order, never
+        // concurrently. Use this for listeners that depend on each other.
+        // Zero means that the listener is independent of all others.
+        uint32_t serialGroup{ 0 };
+
+        // If set, the listener is only called by executor->drain(), on the
+        // executor's thread, in every dispatch mode. Affinity and serial
+        // group are ignored. The executor must outlive the listener's
+        // registration.
+        EventExecutor* executor{ nullptr };
+    };
+
+    /**
+     * @brief Handle to a callback registered with EventHandler::subscribe()
+     *
+     * Unsubscribes the callback when destroyed. Can only be moved.
+     */
+    class EventSubscription
+    {
+    public:
+        EventSubscription() = default;
+        EventSubscription(const EventSubscription&) = delete;
+        EventSubscription(EventSubscription&& other) noexcept;
+        EventSubscription& operator=(const EventSubscription&) = delete;
+        EventSubscription& operator=(EventSubscription&& rhs) noexcept;
+        ~EventSubscription();
+
+        /**
+         * @brief Remove the callback from the event handler
+         *
+         * Does nothing if the subscription is already inactive. Waits if
+         * the callback is currently running on the event handler thread,
+         * so the callback is never called after this has returned.
+         */
+        void unsubscribe();
+
+    private:
+        friend class EventHandler;
+        EventSubscription(EventTypeId type, uint64_t id);
+
+        EventTypeId type{ INVALID_EVENT_TYPE_ID };
+        uint64_t id{ 0 };
+    };
 
     class EventHandler
     {
     public:
-        static void init();
+        /**
+         * @brief Configuration of the event handler
+         */
+        struct EventHandlerCreateInfo {
+            EventHandlerCreateInfo() {} // GCC and Clang can't handle default ctors in nested structs
+
+            // Maximum number of pending events. Rounded up to the next
+            // power of two.
+            size_t queueCapacity{ DEFAULT_EVENT_QUEUE_CAPACITY };
+
+            // What notify() does when the queue is full
+            QueueOverflowPolicy overflowPolicy{ QueueOverflowPolicy::block };
+
+            // Number of times the dispatcher thread polls the empty queue
+            // before it goes to sleep. Higher values reduce wake-up latency
+            // for bursts of events at the cost of CPU time. Zero parks the
+            // thread immediately.
+            uint32_t spinCount{ DEFAULT_DISPATCHER_SPIN_COUNT };
+
+            // Dispatch on a dedicated thread, on a thread pool, or on the
+            // thread that calls dispatchEvents()
+            EventDispatchMode dispatchMode{ EventDispatchMode::asynchronous };
+
+            // Number of threads in the pool that listeners are called on in
+            // EventDispatchMode::parallel. Zero uses one thread per
+            // hardware thread.
+            uint32_t workerThreadCount{ 0 };
+        };
+
+        /**
+         * @brief Start the event handler
+         *
+         * Starts the event handler thread in asynchronous mode, plus the
+         * listener thread pool in parallel mode. In synchronous mode, the
+         * calling thread becomes the thread that dispatches events.
+         *
+         * Does nothing if the event handler is already running. Call this
+         * before Window::create() to use a configuration other than the
+         * default. Creates a new event queue, so the capacity and overflow
+         * policy may differ from the last run.
+         */
+        static void init(const EventHandlerCreateInfo& info = {});
+
+        /**
+         * @brief Stop the event handler
+         *
+         * Dispatches all events that are still pending, then joins the
+         * event handler thread and the listener thread pool. Does nothing
+         * if the event handler is not running. The event handler can be
+         * restarted with init().
+         *
+         * Events that are notified after terminate() has been called are
+         * discarded.
+         *
+         * If called from a listener (i.e. from the event handler thread
+         * itself), the thread stops as soon as the queue is empty and is
+         * joined by the next call to init() or at program exit.
+         *
+         * Called by Window::close().
+         */
+        static void terminate();
 
-        static void notify(std::unique_ptr<Event> e);
+        /**
+         * @brief Dispatch all pending events on the calling thread
+         *
+         * Only has an effect in EventDispatchMode::synchronous and when
+         * called from the thread that initialized the event handler. Does
+         * nothing when called from within a listener.
+         *
+         * Called by Window::pollEvents().
+         */
+        static void dispatchEvents();
 
-        static void add(Listener& l);
+        /**
+         * @brief Enqueue an event for dispatch
+         *
+         * Thread safe and lock-free. Wakes the event handler thread if it
+         * is sleeping on an empty queue. The event is discarded if the
+         * event handler is not running, i.e. before init() or after
+         * terminate().
+         *
+         * The event is moved into the queue by value, so this does not
+         * allocate unless the event is larger than INLINE_EVENT_SIZE.
+         *
+         * The event is delivered to all listeners and to all callbacks
+         * subscribed to T. T is the static type of the event, so
+         * notify<Event>(KeyPressEvent(...)) does not reach subscribers of
+         * KeyPressEvent.
+         *
+         * Input and window events are written to the InputRecorder's file
+         * if a recording is running and they have been enqueued.
+         */
+        template<class T>
+        static void notify(T event);
+
+        /**
+         * @brief Enqueue an event for dispatch after a delay
+         *
+         * The event is passed to notify() once the delay has expired. It
+         * is timestamped at that point, not when it was scheduled. The
+         * event handler thread sleeps until the next timer expires, so
+         * this does not poll. In EventDispatchMode::synchronous, expired
+         * timers are processed by dispatchEvents().
+         *
+         * Thread safe.
+         *
+         * @return TimerId Can be passed to cancelTimer()
+         */
+        template<class T>
+        static auto notifyAfter(Clock::duration delay, T event) -> TimerId;
+
+        /**
+         * @brief Enqueue a copy of an event periodically
+         *
+         * The first copy is passed to notify() after one period. Periods
+         * that have been missed, for example because
+         * dispatchEvents() has not been called in time, are skipped
+         * instead of being sent in a burst.
+         *
+         * Thread safe.
+         *
+         * @return TimerId Must be passed to cancelTimer() to stop the timer
+         */
+        template<class T>
+        static auto notifyEvery(Clock::duration period, T event) -> TimerId;
+
+        /**
+         * @brief Stop a timer created by notifyAfter() or notifyEvery()
+         *
+         * @return bool False if the timer has already expired or been
+         *              cancelled
+         */
+        static bool cancelTimer(TimerId timer);
+
+        /**
+         * @brief Register a listener. Called by the Listener constructor.
+         */
+        static void add(Listener& l, const ListenerDispatchInfo& info = {});
+
+        /**
+         * @brief Unregister a listener. Called by the Listener destructor.
+         *
+         * Waits until the listener has returned if it is currently called
+         * on another thread. The listener is never called after this
+         * function has returned. However, the derived part of the listener
+         * is already destroyed when the Listener destructor gets here, so
+         * a listener that may still receive events on another thread must
+         * be removed explicitly before it is destroyed.
+         *
+         * Neither add() nor remove() block the dispatch of events.
+         */
         static void remove(Listener& l);
 
+        /**
+         * @brief Register a callback for a single event type
+         *
+         * The callback is called on the event handler thread for every
+         * event of exactly the type T, also in EventDispatchMode::parallel.
+         * Events of types derived from T are not delivered. In contrast to
+         * Listener::onEvent(), this does not need RTTI to filter events;
+         * events of other types never visit the callback.
+         *
+         * Example:
+         *
+         *      auto sub = EventHandler::subscribe<MouseMoveEvent>(
+         *          [](const MouseMoveEvent& e) { ... }
+         *      );
+         *
+         * @tparam T The event type. Must be derived from Event.
+         * @param std::function<void(const T&)> callback
+         *
+         * @return EventSubscription The callback is unsubscribed when the
+         *                           subscription is destroyed.
+         */
+        template<class T> [[nodiscard]]
+        static auto subscribe(std::function<void(const T&)> callback) -> EventSubscription;
+
+        /**
+         * @brief Enable or disable coalescing for an event type
+         *
+         * With coalescing enabled, consecutive pending events of type T
+         * are merged into a single event before they are dispatched.
+         * Coalescing happens within the batch of events that is collected
+         * for one dispatch. This
+         * only affects events that are directly adjacent in the queue, so
+         * the order relative to events of other types is preserved. For
+         * example, mouse moves around a button press are never merged
+         * across the press.
+         *
+         * Merging is done by calling later.coalesce(earlier) on the later
+         * event, which must have the signature
+         *
+         *      void T::coalesce(const T& previous)
+         *
+         * MouseMoveEvent (keeps the latest position) and MouseScrollEvent
+         * (sums offsets) implement this. Disabled for all types by default.
+         *
+         * @tparam T The event type. Must be derived from Event.
+         */
+        template<class T>
+        static void setCoalescing(bool enabled);
+
+        /**
+         * @return size_t Number of events that have been discarded because
+         *                the queue was full
+         */
+        static auto getDroppedEventCount() -> size_t;
+
+        /**
+         * @return size_t Number of events that had to be allocated on the
+         *                heap because they were too large to be stored in
+         *                the queue. Zero as long as only events defined by
+         *                the library are used.
+         */
+        static auto getHeapAllocatedEventCount() -> size_t;
+
     private:
+        friend class EventSubscription;
+        friend class EventExecutor;
+
+        using EventQueue = MpscRingBuffer<StoredEvent>;
+
+        // Merges the earlier of two events into the later one
+        using CoalesceFunc = void(*)(Event& later, const Event& earlier);
+
+        // Events handed to the thread pool in parallel mode. Owns the
+        // events because the queue slots are reused immediately. Batches
+        // are recycled, so their storage is only allocated while the
+        // number of batches in flight grows.
+        struct SharedEventBatch
+        {
+            std::vector<StoredEvent> events;
+            std::vector<const Event*> pointers;
+            std::atomic<uint32_t> refCount{ 0 };
+        };
+
+        // Calls its member listeners one after another on the thread pool.
+        // Every independent listener has its own actor, listeners in a
+        // serial group share one.
+        struct DispatchActor
+        {
+            uint32_t serialGroup{ 0 };
+
+            std::mutex lock;
+            std::condition_variable idle;
+
+            // Removed listeners are set to nullptr while the actor is
+            // scheduled and erased once it is idle
+            std::vector<Listener*> members;
+            std::vector<SharedEventBatch*> mailbox;
+            std::vector<SharedEventBatch*> processing;
+            bool scheduled{ false };
+
+            Listener* current{ nullptr };
+            std::thread::id currentThread;
+        };
+
+        // Lets the removal of a listener or callback wait for a dispatch
+        // that still uses an older dispatch table. The dispatcher announces
+        // the call in inFlight before it checks removed, the remover sets
+        // removed before it checks inFlight, so at least one of them sees
+        // the other.
+        struct EntryGuard
+        {
+            std::atomic<bool> removed{ false };
+            std::atomic<uint32_t> inFlight{ 0 };
+
+            bool enter() noexcept
+            {
+                inFlight.fetch_add(1);
+                if (removed.load())
+                {
+                    leave();
+                    return false;
+                }
+                return true;
+            }
+
+            void leave() noexcept {
+                inFlight.fetch_sub(1, std::memory_order_release);
+            }
+
+            void retire(bool wait) noexcept
+            {
+                // Both loads must be sequentially consistent, or enter()
+                // and retire() can miss each other's store
+                removed.store(true);
+                while (wait && inFlight.load() != 0) {
+                    std::this_thread::yield();
+                }
+            }
+        };
+
+        // The batches routed to an EventExecutor and the listeners that
+        // its owner calls. The dispatcher is the only producer, the owner
+        // the only consumer. The guard lets the executor's destructor wait
+        // until the dispatcher has stopped pushing to the queue.
+        struct ExecutorQueue : EntryGuard
+        {
+            explicit ExecutorQueue(size_t capacity) : batches(capacity) {}
+
+            SpscRingBuffer<SharedEventBatch*> batches;
+            const std::thread::id owner{ std::this_thread::get_id() };
+
+            std::mutex lock;
+            std::condition_variable idle;
+
+            // Removed listeners are set to nullptr while the owner drains
+            // and erased afterwards
+            std::vector<Listener*> members;
+            bool draining{ false };
+            Listener* current{ nullptr };
+        };
+
+        struct ListenerEntry : EntryGuard
+        {
+            Listener* listener{ nullptr };
+            ListenerDispatchInfo info;
+
+            // Null for listeners with ListenerAffinity::dispatcher
+            std::shared_ptr<DispatchActor> actor;
+
+            // Set for listeners that are routed to an executor
+            std::shared_ptr<ExecutorQueue> executor;
+        };
+
+        struct Subscriber : EntryGuard
+        {
+            uint64_t id{ 0 };
+            std::function<void(const Event&)> callback;
+        };
+
+        // An immutable snapshot of everything the dispatcher reads. Changes
+        // copy the current table and publish the copy, so the dispatcher
+        // never waits for add(), remove() or subscribe(), and those only
+        // contend with each other.
+        struct DispatchTable
+        {
+            std::vector<std::shared_ptr<ListenerEntry>> listeners;
+            std::vector<std::shared_ptr<DispatchActor>> actors;
+
+            // Executors that have at least one listener
+            std::vector<std::shared_ptr<ExecutorQueue>> executors;
+
+            // Indexed by event type id
+            std::vector<std::vector<std::shared_ptr<Subscriber>>> subscribers;
+
+            // Indexed by event type id. Null if coalescing is disabled.
+            std::vector<CoalesceFunc> coalesceFuncs;
+        };
+
+        static auto addSubscriber(EventTypeId type, std::function<void(const Event&)> callback)
+            -> EventSubscription;
+        static void removeSubscriber(EventTypeId type, uint64_t id);
+        static void setCoalesceFunc(EventTypeId type, CoalesceFunc func);
+
+        // Dispatches all events that are published at the time of the
+        // call as a single batch. Events notified by listeners during the
+        // dispatch are left for the next call.
+        static void dispatchPending();
+        static auto collectBatch(const DispatchTable& table) -> size_t;
+        static bool handleFullQueue();
+
+        // Moves the collected events into a batch that can outlive the
+        // queue slots. The dispatcher thread holds one reference in
+        // addition to the given count.
+        static auto shareBatch(uint32_t refCount) -> SharedEventBatch*;
+        static void postToActors(const DispatchTable& table, SharedEventBatch* batch);
+        static void runActor(DispatchActor& actor);
+        static void postToExecutors(const DispatchTable& table, SharedEventBatch* batch);
+        static auto runExecutor(ExecutorQueue& queue) -> size_t;
+        static void closeExecutor(const std::shared_ptr<ExecutorQueue>& queue);
+        static auto acquireBatch() -> SharedEventBatch*;
+        static void releaseBatch(SharedEventBatch* batch);
+
+        // Copies the current table, applies the change and publishes the
+        // copy
+        template<typename F>
+        static void modifyTable(F&& modify);
+
+        // Picks up the latest table on the dispatcher thread
+        static auto acquireDispatchTable() -> const DispatchTable&;
+
+        template<class T>
+        static auto scheduleEvent(Clock::duration delay, Clock::duration period, T event) -> TimerId;
+
+        // Applies the overflow policy. Returns false if the event has
+        // been discarded.
+        template<class T>
+        static bool enqueue(T&& event);
+
         static void run();
+        static void discardPending();
+        static void waitForEvents();
+        static void wakeDispatcher();
+
+        static inline std::unique_ptr<EventQueue> pendingEvents;
+
+        // Only held by writers. The version is incremented after each new
+        // table has been published.
+        static inline std::mutex tableLock;
+        static inline std::shared_ptr<const DispatchTable> table{ std::make_shared<DispatchTable>() };
+        static inline std::atomic<uint64_t> tableVersion{ 0 };
+        static inline uint64_t nextSubscriberId{ 1 };
+
+        // The dispatcher's reference to the table it uses. Keeps the table
+        // alive while it is read, even if a newer one has been published.
+        static inline std::shared_ptr<const DispatchTable> dispatchTable;
+        static inline uint64_t dispatchTableVersion{ 0 };
+
+        // The events passed to Listener::onEvents() and their queue slots.
+        // Reserved to the queue capacity, so collecting a batch does not
+        // allocate.
+        static inline std::vector<const Event*> currentBatch;
+        static inline std::vector<StoredEvent*> collectedEvents;
+
+        // Parallel mode only. The pool is declared after the batches
+        // because its destructor still runs pending actors.
+        static inline std::mutex batchPoolLock;
+        static inline std::vector<std::unique_ptr<SharedEventBatch>> batchPool;
+        static inline std::vector<SharedEventBatch*> freeBatches;
+        static inline std::unique_ptr<ThreadPool> workerPool;
+
+        static inline uint32_t spinCount{ DEFAULT_DISPATCHER_SPIN_COUNT };
+        static inline bool synchronousDispatch{ false };
+
+        // The thread that dispatches events and whether it is currently
+        // doing so. Needed to keep it from blocking on its own queue.
+        static inline std::atomic<std::thread::id> consumerThread;
+        static inline bool dispatching{ false };
+        static inline std::atomic<size_t> droppedEventCount{ 0 };
+        static inline std::atomic<bool> stopRequested{ false };
+
+        // Between init() and terminate(). Nothing is enqueued while this
+        // is false.
+        static inline std::atomic<bool> running{ false };
+
+        // Number of threads in notify(). Incremented before running is
+        // checked, so init() can't miss a producer that has seen it true.
+        static inline std::atomic<uint32_t> activeProducers{ 0 };
+        struct ProducerScope
+        {
+            ProducerScope() { activeProducers.fetch_add(1); }
+            ~ProducerScope() { activeProducers.fetch_sub(1, std::memory_order_release); }
+        };
+        static inline std::atomic<bool> dispatcherParked{ false };
+        static inline std::mutex wakeLock;
+        static inline std::condition_variable wakeCondition;
+
+        // Deferred and periodic events. Advanced by the thread that
+        // dispatches events.
+        static inline TimerWheel timers;
+
+        // Joins the dispatcher thread at program exit if terminate() has
+        // not been called. Declared last so that it is destroyed before the
+        // state the thread accesses.
+        struct DispatcherThread
+        {
+            ~DispatcherThread();
+            std::thread thread;
+        };
+        static inline DispatcherThread dispatcher;
+    };
+
+    /**
+     * @brief Calls listeners on a thread of the user's choice
+     *
+     * Some listeners have to run on a specific thread, for example
+     * listeners that reallocate framebuffers when the window is resized
+     * must run on the OpenGL thread. Listeners registered with an executor
+     * (see ListenerDispatchInfo::executor) are not called by the event
+     * handler. Instead, the event handler routes every batch of events
+     * into the executor's queue, and the thread that owns the executor
+     * calls the listeners when it calls drain(). The listeners don't need
+     * to synchronize with anything else on that thread.
+     *
+     * Example:
+     *
+     *      EventExecutor glThread;  // Created on the OpenGL thread
+     *      ListenerDispatchInfo info;
+     *      info.executor = &glThread;
+     *      MyResizeListener listener(info);
+     *      while (running) {
+     *          Window::pollEvents();
+     *          glThread.drain();
+     *          ...
+     *      }
+     *
+     * The queue is a lock-free single-producer/single-consumer queue of
+     * shared batches, so routing does not copy events. If the queue is
+     * full, the event handler waits for the owner to drain it, or drains it
+     * itself if it runs on the owner thread.
+     *
+     * Not copyable or movable.
+     */
+    class EventExecutor
+    {
+    public:
+        /**
+         * @brief Create an executor owned by the calling thread
+         */
+        EventExecutor();
+        explicit EventExecutor(size_t queueCapacity);
+
+        EventExecutor(const EventExecutor&) = delete;
+        EventExecutor(EventExecutor&&) noexcept = delete;
+        EventExecutor& operator=(const EventExecutor&) = delete;
+        EventExecutor& operator=(EventExecutor&&) noexcept = delete;
+
+        /**
+         * @brief Unregister all listeners of the executor
+         *
+         * Batches that have not been drained yet are discarded.
+         */
+        ~EventExecutor();
+
+        /**
+         * @brief Call the executor's listeners with all pending batches
+         *
+         * Must be called on the thread that created the executor. Does
+         * nothing if called recursively from one of its listeners.
+         *
+         * @return size_t Number of batches that have been processed
+         *
+         * @throw std::runtime_error if called on another thread
+         */
+        auto drain() -> size_t;
+
+        /**
+         * @return std::thread::id The thread that created the executor
+         */
+        [[nodiscard]]
+        auto getOwnerThread() const noexcept -> std::thread::id;
+
+    private:
+        friend class EventHandler;
 
-        static inline std::mutex listenerLock;
-        static inline std::queue<Event*> pendingEvents;
-        static inline std::vector<Listener*> listeners;
+        std::shared_ptr<EventHandler::ExecutorQueue> queue;
     };
+
+
+
+    template<typename F>
+    void EventHandler::modifyTable(F&& modify)
+    {
+        std::lock_guard lock(tableLock);
+
+        auto next = std::make_shared<DispatchTable>(*table);
+        modify(*next);
+        table = std::move(next);
+        tableVersion.fetch_add(1, std::memory_order_release);
+    }
+
+    template<class T>
+    void EventHandler::notify(T event)
+    {
+        static_assert(Event::isEventType<T>, "glb::EventHandler::notify<> template parameter must be derived from glb::Event. "
+                                             "Pass events by value, not as pointers.");
+
+        // Keeps init() from replacing the queue while it is accessed
+        ProducerScope scope;
+        if (!running.load()) return;
+
+        event.typeId = getEventTypeId<T>();
+
+        // Only record events that the dispatcher will actually see. The
+        // event is moved into the queue, so a copy is recorded.
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            if (InputRecorder::isRecording())
+            {
+                const T recorded = event;
+                if (enqueue(std::move(event))) {
+                    InputRecorder::record(recorded);
+                }
+                return;
+            }
+        }
+
+        enqueue(std::move(event));
+    }
+
+    template<class T>
+    bool EventHandler::enqueue(T&& event)
+    {
+        if (!pendingEvents->tryEmplace(std::move(event)))
+        {
+            // The event is only moved from if it has been enqueued
+            if (!handleFullQueue()) return false;
+            if (!pendingEvents->emplace(std::move(event))) return false;
+        }
+        wakeDispatcher();
+
+        return true;
+    }
+
+    template<class T>
+    auto EventHandler::notifyAfter(Clock::duration delay, T event) -> TimerId
+    {
+        return scheduleEvent<T>(delay, Clock::duration::zero(), std::move(event));
+    }
+
+    template<class T>
+    auto EventHandler::notifyEvery(Clock::duration period, T event) -> TimerId
+    {
+        return scheduleEvent<T>(period, period, std::move(event));
+    }
+
+    template<class T>
+    auto EventHandler::scheduleEvent(Clock::duration delay, Clock::duration period, T event) -> TimerId
+    {
+        static_assert(Event::isEventType<T>, "glb::EventHandler::notifyAfter<> template parameter must be derived from glb::Event");
+        static_assert(std::is_copy_constructible_v<T>, "glb::EventHandler::notifyAfter<> template parameter must be copyable");
+
+        const TimerId id = timers.schedule(
+            Clock::now() + delay,
+            period,
+            [event = std::move(event)]() {
+                T copy(event);
+                copy.timestamp = Clock::now();
+                notify<T>(std::move(copy));
+            }
+        );
+
+        // The dispatcher may sleep until a later deadline
+        wakeDispatcher();
+
+        return id;
+    }
+
+    template<class T>
+    auto EventHandler::subscribe(std::function<void(const T&)> callback) -> EventSubscription
+    {
+        static_assert(Event::isEventType<T>, "glb::EventHandler::subscribe<> template parameter must be derived from glb::Event");
+        static_assert(Event::isDecayed<T>, "glb::EventHandler::subscribe<> template parameter must be a decayed type");
+
+        return addSubscriber(
+            getEventTypeId<T>(),
+            [callback = std::move(callback)](const Event& e) {
+                callback(static_cast<const T&>(e));
+            }
+        );
+    }
+
+    template<class T>
+    void EventHandler::setCoalescing(bool enabled)
+    {
+        static_assert(Event::isEventType<T>, "glb::EventHandler::setCoalescing<> template parameter must be derived from glb::Event");
+        static_assert(Event::isDecayed<T>, "glb::EventHandler::setCoalescing<> template parameter must be a decayed type");
+
+        CoalesceFunc func{ nullptr };
+        if (enabled)
+        {
+            func = [](Event& later, const Event& earlier) {
+                static_cast<T&>(later).coalesce(static_cast<const T&>(earlier));
+            };
+        }
+        setCoalesceFunc(getEventTypeId<T>(), func);
+    }
 } // namespace glb
 
-#endif
\ No newline at end of file
+#endif
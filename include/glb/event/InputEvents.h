@@ -7,6 +7,7 @@ using namespace glm;
 
 #include "Event.h"
 #include "KeyDefinitions.h"
+#include "../InputState.h"
 
 namespace glb
 {
@@ -52,7 +53,11 @@ namespace glb
     class MouseEvent : public InputEvent
     {
     public:
-        explicit MouseEvent(vec2 cursorPosition = cursorPos);
+        /**
+         * @param vec2 cursorPosition Defaults to the cursor position of the
+         *                            latest InputState snapshot
+         */
+        explicit MouseEvent(vec2 cursorPosition = InputState::getCursorPos());
         MouseEvent(const MouseEvent&) = default;
         MouseEvent(MouseEvent&&) noexcept = default;
         ~MouseEvent() override = default;
@@ -60,7 +65,8 @@ namespace glb
         MouseEvent& operator=(const MouseEvent&) = default;
         MouseEvent& operator=(MouseEvent&&) noexcept = default;
 
-        static inline vec2 cursorPos;
+        // The cursor position at the time the event was created
+        vec2 position;
     };
 
 
@@ -68,7 +74,7 @@ namespace glb
     class MouseButtonEvent : public MouseEvent
     {
     protected:
-        MouseButtonEvent(eMouseButton button, eKeyMod mods);
+        MouseButtonEvent(eMouseButton button, eKeyMod mods, vec2 cursorPosition);
 
     public:
         const eMouseButton button;
@@ -78,15 +84,17 @@ namespace glb
     class MouseButtonPressEvent : public MouseButtonEvent
     {
     public:
-        MouseButtonPressEvent(eMouseButton button, eKeyMod mods)
-            : MouseButtonEvent(button, mods) {}
+        MouseButtonPressEvent(eMouseButton button, eKeyMod mods,
+                              vec2 cursorPosition = InputState::getCursorPos())
+            : MouseButtonEvent(button, mods, cursorPosition) {}
     };
 
     class MouseButtonReleaseEvent : public MouseButtonEvent
     {
     public:
-        MouseButtonReleaseEvent(eMouseButton button, eKeyMod mods)
-            : MouseButtonEvent(button, mods) {}
+        MouseButtonReleaseEvent(eMouseButton button, eKeyMod mods,
+                                vec2 cursorPosition = InputState::getCursorPos())
+            : MouseButtonEvent(button, mods, cursorPosition) {}
     };
 
 
@@ -96,6 +104,37 @@ namespace glb
     public:
         explicit MouseMoveEvent(vec2 cursorPosition)
             : MouseEvent(cursorPosition) {}
+
+        /**
+         * Merge a directly preceding move event into this one. Only the
+         * latest position is kept. See EventHandler::setCoalescing().
+         */
+        void coalesce(const MouseMoveEvent& /*previous*/) noexcept {}
+    };
+
+
+    /* +++ MouseMotionEvent +++ */
+    /**
+     * Generated once per Window::pollEvents() while the cursor is disabled,
+     * with the cursor motion accumulated since the previous call. Raw,
+     * unaccelerated motion if raw mouse motion is enabled.
+     */
+    class MouseMotionEvent : public MouseEvent
+    {
+    public:
+        explicit MouseMotionEvent(vec2 delta,
+                                  vec2 cursorPosition = InputState::getCursorPos())
+            : MouseEvent(cursorPosition), delta(delta) {}
+
+        /**
+         * Merge a directly preceding motion event into this one. The
+         * deltas are summed. See EventHandler::setCoalescing().
+         */
+        void coalesce(const MouseMotionEvent& previous) noexcept {
+            delta += previous.delta;
+        }
+
+        vec2 delta;
     };
 
 
@@ -103,8 +142,17 @@ namespace glb
     class MouseScrollEvent : public MouseEvent
     {
     public:
-        explicit MouseScrollEvent(vec2 scrollOffset)
-            : scrollOffset(scrollOffset) {}
+        explicit MouseScrollEvent(vec2 scrollOffset,
+                                  vec2 cursorPosition = InputState::getCursorPos())
+            : MouseEvent(cursorPosition), scrollOffset(scrollOffset) {}
+
+        /**
+         * Merge a directly preceding scroll event into this one. The
+         * offsets are summed. See EventHandler::setCoalescing().
+         */
+        void coalesce(const MouseScrollEvent& previous) noexcept {
+            scrollOffset += previous.scrollOffset;
+        }
 
         vec2 scrollOffset;
     };
@@ -0,0 +1,155 @@
+#pragma once
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <vector>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "../Clock.h"
+#include "Event.h"
+
+namespace glb
+{
+    /**
+     * @brief Records all input and window events into a binary file
+     *
+     * While recording, every KeyEvent, MouseButtonEvent, MouseMoveEvent,
+     * MouseMotionEvent, MouseScrollEvent, WindowCreateEvent,
+     * WindowCloseEvent and WindowResizeEvent that is passed to
+     * EventHandler::notify() is written to the file with the time since
+     * the start of the recording. Other events are ignored. Play the file
+     * back with InputReplay.
+     *
+     * The file consists of a header followed by one record per event:
+     *
+     *      header: char[8] "GLBINPUT", uint32 version
+     *      record: uint8 type tag, int64 nanoseconds since start, payload
+     *
+     * The payload of every mouse event ends with the cursor position at
+     * the time of the event, so that replayed events don't take it from
+     * the live InputState. All values are stored in native byte order.
+     */
+    class InputRecorder
+    {
+    public:
+        /**
+         * @brief Start recording into a file
+         *
+         * Stops a recording that is already running. The file is
+         * overwritten.
+         *
+         * @throw std::runtime_error if the file cannot be opened
+         */
+        static void start(const fs::path& file);
+
+        /**
+         * @brief Stop recording and close the file
+         *
+         * Does nothing if no recording is running.
+         */
+        static void stop();
+
+        [[nodiscard]]
+        static bool isRecording() noexcept {
+            return recording.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @return size_t Number of events written by the current or the
+         *                last recording
+         */
+        static auto getRecordedEventCount() -> size_t;
+
+    private:
+        friend class EventHandler;
+
+        // Called by EventHandler::notify() while recording
+        static void record(const Event& event);
+
+        static inline std::atomic<bool> recording{ false };
+        static inline std::mutex lock;
+        static inline std::ofstream file;
+        static inline Clock::time_point startTime;
+        static inline size_t recordedEvents{ 0 };
+    };
+
+    /**
+     * @brief How fast InputReplay injects events
+     */
+    enum class ReplayTiming
+    {
+        // Every event is injected at its original time relative to the
+        // start of the replay
+        original,
+
+        // All events are injected immediately one after another
+        asFastAsPossible,
+    };
+
+    /**
+     * @brief Plays back a file written by InputRecorder
+     *
+     * The events are passed to EventHandler::notify() exactly as the
+     * window would, so no window and no GLFW are needed. The event
+     * handler must be initialized with EventHandler::init() before
+     * play() is called.
+     *
+     * Example of a headless benchmark:
+     *
+     *      EventHandler::init();
+     *      InputReplay replay("trace.bin");
+     *      replay.play(ReplayTiming::asFastAsPossible);
+     *      EventHandler::terminate();
+     */
+    class InputReplay
+    {
+    public:
+        /**
+         * @brief Load a recording into memory
+         *
+         * @throw std::runtime_error if the file cannot be read or is not a
+         *        valid recording
+         */
+        explicit InputReplay(const fs::path& file);
+
+        /**
+         * @brief Inject all recorded events
+         *
+         * Blocks until the last event has been passed to the event
+         * handler. Can be called repeatedly.
+         */
+        void play(ReplayTiming timing = ReplayTiming::original) const;
+
+        /**
+         * @return size_t Number of recorded events
+         */
+        [[nodiscard]]
+        auto size() const noexcept -> size_t;
+
+        /**
+         * @return Clock::duration Time between the start of the recording
+         *                         and the last event
+         */
+        [[nodiscard]]
+        auto getDuration() const noexcept -> Clock::duration;
+
+    private:
+        struct Record
+        {
+            uint8_t tag;
+            std::chrono::nanoseconds time;
+            int32_t ints[4];
+            // Payload of mouse events, followed by the cursor position
+            float floats[4];
+        };
+
+        std::vector<Record> records;
+    };
+} // namespace glb
+
+#endif
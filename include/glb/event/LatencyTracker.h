@@ -0,0 +1,192 @@
+#pragma once
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <filesystem>
+namespace fs = std::filesystem;
+
+#include "../Clock.h"
+#include "Event.h"
+#include "EventBatch.h"
+
+namespace glb
+{
+    /**
+     * @brief A histogram of durations with a relative error of about 6%
+     *
+     * Durations are sorted into log-linear buckets: every power of two is
+     * split into 16 buckets of equal width. Recording is lock-free and may
+     * be done from any number of threads. Reads are not synchronized with
+     * concurrent writes, so they may miss the latest samples.
+     */
+    class LatencyHistogram
+    {
+    public:
+        void record(Clock::duration duration) noexcept;
+
+        [[nodiscard]]
+        auto getCount() const noexcept -> uint64_t;
+
+        /**
+         * @param double percentile In the range [0, 100]
+         *
+         * @return Clock::duration The lower bound of the bucket that
+         *                         contains the percentile. Zero if the
+         *                         histogram is empty.
+         */
+        [[nodiscard]]
+        auto getPercentile(double percentile) const noexcept -> Clock::duration;
+
+        [[nodiscard]]
+        auto getMax() const noexcept -> Clock::duration;
+
+        void reset() noexcept;
+
+    private:
+        static constexpr uint32_t SUB_BUCKET_BITS = 4;
+        static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static constexpr uint32_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        static auto getBucket(uint64_t nanoseconds) noexcept -> uint32_t;
+        static auto getLowerBound(uint32_t bucket) noexcept -> uint64_t;
+
+        std::atomic<uint64_t> buckets[BUCKET_COUNT]{};
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> max{ 0 };
+    };
+
+    /**
+     * @brief The points in an event's life at which its latency is measured
+     *
+     * All latencies are measured from the event's creation, see
+     * Event::getTimestamp().
+     */
+    enum class LatencyStage
+    {
+        // The event handler has taken the event from the queue
+        dispatch,
+
+        // A listener has returned from onEvents() or a subscribed callback
+        // has returned. Recorded once per listener.
+        delivery,
+
+        // The first Window::swapBuffers() after all listeners on the event
+        // handler thread have returned. In parallel mode, listeners on the
+        // thread pool may still be running at that point. Only the first
+        // few thousand events dispatched between two frames are recorded.
+        frame,
+
+        numStages,
+    };
+
+    struct LatencyStatistics
+    {
+        uint64_t count{ 0 };
+        Clock::duration p50{ 0 };
+        Clock::duration p99{ 0 };
+        Clock::duration max{ 0 };
+    };
+
+    /**
+     * @brief Per-event-type latency histograms
+     *
+     * Measures the time from the creation of an event (i.e. from the GLFW
+     * callback for input events) to its dispatch, to the return of each
+     * listener and to the next frame. Disabled by default. While disabled,
+     * the event handler does not pay more than a single flag check per
+     * batch.
+     *
+     * Events are grouped by the type they were notified with, see
+     * EventHandler::notify(). Up to MAX_TRACKED_EVENT_TYPES types are
+     * tracked, events with higher type ids are ignored.
+     */
+    class LatencyTracker
+    {
+    public:
+        static constexpr EventTypeId MAX_TRACKED_EVENT_TYPES = 64;
+
+        static void setEnabled(bool enabled) noexcept;
+
+        [[nodiscard]]
+        static bool isEnabled() noexcept {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @tparam T The event type. Must be derived from Event.
+         */
+        template<class T>
+        static auto getStatistics(LatencyStage stage) -> LatencyStatistics;
+        static auto getStatistics(EventTypeId type, LatencyStage stage) -> LatencyStatistics;
+
+        /**
+         * @brief Clear all histograms
+         */
+        static void reset();
+
+        /**
+         * @brief Write the statistics of all tracked event types to a file
+         *
+         * The file is a text table with one line per event type and stage.
+         * Times are in microseconds.
+         *
+         * @throw std::runtime_error if the file cannot be opened
+         */
+        static void writeReport(const fs::path& file);
+
+        /**
+         * @brief Record the frame latency of all events dispatched since
+         *        the last frame
+         *
+         * Called by Window::swapBuffers().
+         */
+        static void recordFrame();
+
+    private:
+        friend class EventHandler;
+
+        // Called on the event handler thread
+        static void recordDispatch(const EventBatch& events);
+
+        // Called on any thread that runs a listener
+        static void recordDelivery(const EventBatch& events);
+        static void recordDelivery(const Event& event);
+
+        struct TypeStatistics
+        {
+            const char* name;
+            LatencyHistogram histograms[static_cast<size_t>(LatencyStage::numStages)];
+        };
+
+        static auto getTypeStatistics(const Event& event) -> TypeStatistics*;
+
+        static inline std::atomic<bool> enabled{ false };
+
+        // Never freed. Listener threads that outlive static destruction may
+        // still record into them.
+        static inline std::atomic<TypeStatistics*> types[MAX_TRACKED_EVENT_TYPES]{};
+
+        // Dispatched events that wait for the next frame. Events beyond
+        // the limit are not recorded in the frame stage.
+        static constexpr size_t MAX_PENDING_FRAME_EVENTS = 4096;
+        static inline std::mutex frameLock;
+        static inline std::vector<std::pair<EventTypeId, Clock::time_point>> pendingFrame;
+    };
+
+
+
+    template<class T>
+    auto LatencyTracker::getStatistics(LatencyStage stage) -> LatencyStatistics
+    {
+        static_assert(Event::isEventType<T>, "glb::LatencyTracker::getStatistics<> template parameter must be derived from glb::Event");
+
+        return getStatistics(getEventTypeId<T>(), stage);
+    }
+} // namespace glb
+
+#endif
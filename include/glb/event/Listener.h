@@ -4,19 +4,26 @@
 #include <memory>
 
 #include "Event.h"
+#include "EventBatch.h"
 #include "EventHandler.h"
 
 namespace glb
 {
     /* +++ Listener +++
-    Event listener class. Inherit from this and implement onEvent() to receive events.
-    The Listener()-constructor must be called in the subclass's constructor. */
+    Event listener class. Inherit from this and implement onEvent() or onEvents() to
+    receive events.
+    The Listener()-constructor must be called in the subclass's constructor. Pass a
+    ListenerDispatchInfo to it to control on which thread the listener is called in
+    EventDispatchMode::parallel, or to route it to an EventExecutor. */
     class Listener
     {
     public:
         Listener() {
             EventHandler::add(*this);
         }
+        explicit Listener(const ListenerDispatchInfo& info) {
+            EventHandler::add(*this, info);
+        }
         Listener(const Listener&) = default;
         Listener(Listener&&) noexcept = default;
         Listener& operator=(const Listener&) = default;
@@ -26,9 +33,21 @@ namespace glb
         }
 
         /* +++ onEvent() +++
-        Gets called by EventHandler every time an event occurs.
-        Implemented by subclasses to handle events. */
-        virtual void onEvent(std::shared_ptr<Event> e) = 0;
+        Gets called by the default implementation of onEvents() for every event.
+        Implemented by subclasses to handle events one at a time. The event is only
+        valid for the duration of the call. */
+        virtual void onEvent(const Event& /*e*/) {}
+
+        /* +++ onEvents() +++
+        Gets called by EventHandler once for all events that are dispatched together,
+        in the order in which they occurred. Override this instead of onEvent() to
+        process a frame's worth of input in one tight loop. The events are only
+        valid for the duration of the call. */
+        virtual void onEvents(const EventBatch& events) {
+            for (const Event* e : events) {
+                onEvent(*e);
+            }
+        }
     };
 }
 
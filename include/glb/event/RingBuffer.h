@@ -0,0 +1,380 @@
+#pragma once
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace glb
+{
+    /**
+     * @brief Controls what happens when an element is pushed to a full queue
+     */
+    enum class QueueOverflowPolicy
+    {
+        // The producer yields until the consumer has freed a slot. No
+        // element is ever lost.
+        block,
+
+        // The pushed element is discarded and push returns false. The
+        // number of discarded elements can be queried from the queue.
+        dropNewest,
+    };
+
+    /**
+     * @brief A bounded, lock-free multi-producer/single-consumer queue
+     *
+     * All storage is allocated once at construction. Elements are
+     * constructed in-place in their slot, so a push never allocates.
+     *
+     * Producers claim a slot with a compare-exchange on the tail index and
+     * publish it with a release-store of the slot's sequence number (see
+     * D. Vyukov's bounded MPMC queue). The consumer owns the head index
+     * exclusively and never contends with producers.
+     *
+     * Enqueueing is lock-free, not wait-free: a producer whose
+     * compare-exchange fails retries, so under contention a single
+     * producer may retry an unbounded number of times while others make
+     * progress. Claiming the slot with a fetch-add would be wait-free,
+     * but a claimed slot cannot be given back, so tryEmplace() could not
+     * fail on a full queue and QueueOverflowPolicy::dropNewest could not
+     * be implemented.
+     *
+     * The capacity is rounded up to the next power of two.
+     *
+     * Only a single thread may call the consumer functions empty(),
+     * front(), peek() and pop() at any time. emplace() and tryEmplace() may
+     * be called from any number of threads concurrently.
+     */
+    template<typename T>
+    class MpscRingBuffer
+    {
+    public:
+        explicit MpscRingBuffer(size_t capacity,
+                                QueueOverflowPolicy policy = QueueOverflowPolicy::block)
+            :
+            _capacity(roundUpToPowerOfTwo(capacity)),
+            mask(_capacity - 1),
+            policy(policy),
+            slots(new Slot[_capacity])
+        {
+            for (size_t i = 0; i < _capacity; i++) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRingBuffer(const MpscRingBuffer&) = delete;
+        MpscRingBuffer(MpscRingBuffer&&) noexcept = delete;
+        MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+        MpscRingBuffer& operator=(MpscRingBuffer&&) noexcept = delete;
+
+        ~MpscRingBuffer() {
+            while (!empty()) {
+                pop();
+            }
+        }
+
+        /**
+         * @brief Construct an element at the end of the queue
+         *
+         * Thread safe. Lock-free, does not allocate. Applies the overflow
+         * policy if the queue is full.
+         *
+         * @return bool False if the queue was full and the element has been
+         *              discarded because of QueueOverflowPolicy::dropNewest.
+         *              True otherwise.
+         */
+        template<typename ...Args>
+        bool emplace(Args&&... args)
+        {
+            while (!tryEmplace(std::forward<Args>(args)...))
+            {
+                if (policy == QueueOverflowPolicy::dropNewest)
+                {
+                    droppedCount.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Construct an element at the end of the queue if there is
+         *        space left
+         *
+         * Thread safe. Lock-free but not wait-free, does not allocate.
+         * Ignores the overflow policy. The arguments are left untouched if
+         * the queue is full.
+         *
+         * @return bool False if the queue was full, true otherwise.
+         */
+        template<typename ...Args>
+        bool tryEmplace(Args&&... args)
+        {
+            size_t pos = tail.load(std::memory_order_relaxed);
+            Slot* slot{ nullptr };
+            while (true)
+            {
+                slot = &slots[pos & mask];
+                const size_t seq = slot->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    // The slot still holds an element from the previous lap
+                    return false;
+                }
+                else {
+                    pos = tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (&slot->storage) T(std::forward<Args>(args)...);
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @return bool True if no published element is available to the
+         *              consumer. Consumer only.
+         */
+        [[nodiscard]]
+        bool empty() const noexcept {
+            const Slot& slot = slots[head & mask];
+            return slot.sequence.load(std::memory_order_acquire) != head + 1;
+        }
+
+        /**
+         * @return T& The oldest element in the queue. Consumer only. The
+         *            queue must not be empty.
+         */
+        [[nodiscard]]
+        T& front() noexcept {
+            return *std::launder(reinterpret_cast<T*>(&slots[head & mask].storage));
+        }
+
+        /**
+         * @brief Access a published element behind the front of the queue
+         *
+         * Consumer only.
+         *
+         * @param size_t index Position relative to the front. peek(0) is
+         *                     equivalent to front().
+         *
+         * @return T* The element at the position, nullptr if no published
+         *            element exists at that position.
+         */
+        [[nodiscard]]
+        T* peek(size_t index) noexcept
+        {
+            if (index >= _capacity) return nullptr;
+
+            const size_t pos = head + index;
+            Slot& slot = slots[pos & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return nullptr;
+            }
+            return std::launder(reinterpret_cast<T*>(&slot.storage));
+        }
+
+        /**
+         * @brief Destroy the oldest element and free its slot for producers
+         *
+         * Consumer only. The queue must not be empty.
+         */
+        void pop() noexcept
+        {
+            Slot& slot = slots[head & mask];
+            std::launder(reinterpret_cast<T*>(&slot.storage))->~T();
+            slot.sequence.store(head + _capacity, std::memory_order_release);
+            head++;
+        }
+
+        [[nodiscard]]
+        size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        /**
+         * @return size_t Number of elements discarded because the queue was
+         *                full. Always zero for QueueOverflowPolicy::block.
+         */
+        [[nodiscard]]
+        size_t getDroppedCount() const noexcept {
+            return droppedCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        static constexpr size_t roundUpToPowerOfTwo(size_t n) noexcept {
+            size_t result = 1;
+            while (result < n) result <<= 1;
+            return result;
+        }
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+        };
+
+        const size_t _capacity;
+        const size_t mask;
+        const QueueOverflowPolicy policy;
+        std::unique_ptr<Slot[]> slots;
+
+        // Producers and the consumer write to different cache lines
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{ 0 };
+        alignas(CACHE_LINE_SIZE) size_t head{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> droppedCount{ 0 };
+    };
+
+    /**
+     * @brief A bounded, lock-free single-producer/single-consumer queue
+     *
+     * All storage is allocated once at construction. The producer and the
+     * consumer each own one index and only read the other one when their
+     * cached copy says that the queue is full or empty, so an uncontended
+     * push or pop touches no shared cache line but the slot itself.
+     *
+     * The capacity is rounded up to the next power of two.
+     *
+     * Only a single thread may call tryEmplace() at any time, and only a
+     * single thread may call the consumer functions empty(), front() and
+     * pop() at any time.
+     */
+    template<typename T>
+    class SpscRingBuffer
+    {
+    public:
+        explicit SpscRingBuffer(size_t capacity)
+            :
+            _capacity(roundUpToPowerOfTwo(capacity)),
+            mask(_capacity - 1),
+            slots(new Slot[_capacity])
+        {}
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer(SpscRingBuffer&&) noexcept = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(SpscRingBuffer&&) noexcept = delete;
+
+        ~SpscRingBuffer() {
+            while (!empty()) {
+                pop();
+            }
+        }
+
+        /**
+         * @brief Construct an element at the end of the queue if there is
+         *        space left
+         *
+         * Producer only. Lock-free, does not allocate. The arguments are
+         * left untouched if the queue is full.
+         *
+         * @return bool False if the queue was full, true otherwise.
+         */
+        template<typename ...Args>
+        bool tryEmplace(Args&&... args)
+        {
+            const size_t pos = tail.load(std::memory_order_relaxed);
+            if (pos - cachedHead == _capacity)
+            {
+                cachedHead = head.load(std::memory_order_acquire);
+                if (pos - cachedHead == _capacity) {
+                    return false;
+                }
+            }
+
+            new (&slots[pos & mask].storage) T(std::forward<Args>(args)...);
+            tail.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @return bool True if no published element is available to the
+         *              consumer. Consumer only.
+         */
+        [[nodiscard]]
+        bool empty() noexcept
+        {
+            const size_t pos = head.load(std::memory_order_relaxed);
+            if (pos == cachedTail) {
+                cachedTail = tail.load(std::memory_order_acquire);
+            }
+            return pos == cachedTail;
+        }
+
+        /**
+         * @return T& The oldest element in the queue. Consumer only. The
+         *            queue must not be empty.
+         */
+        [[nodiscard]]
+        T& front() noexcept
+        {
+            const size_t pos = head.load(std::memory_order_relaxed);
+            return *std::launder(reinterpret_cast<T*>(&slots[pos & mask].storage));
+        }
+
+        /**
+         * @brief Destroy the oldest element and free its slot for the
+         *        producer
+         *
+         * Consumer only. The queue must not be empty.
+         */
+        void pop() noexcept
+        {
+            const size_t pos = head.load(std::memory_order_relaxed);
+            std::launder(reinterpret_cast<T*>(&slots[pos & mask].storage))->~T();
+            head.store(pos + 1, std::memory_order_release);
+        }
+
+        [[nodiscard]]
+        size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+    private:
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        static constexpr size_t roundUpToPowerOfTwo(size_t n) noexcept {
+            size_t result = 1;
+            while (result < n) result <<= 1;
+            return result;
+        }
+
+        struct Slot
+        {
+            std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+        };
+
+        const size_t _capacity;
+        const size_t mask;
+        std::unique_ptr<Slot[]> slots;
+
+        // Each index and the cached copy of the other one are only written
+        // by one side
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{ 0 };
+        size_t cachedHead{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{ 0 };
+        size_t cachedTail{ 0 };
+    };
+} // namespace glb
+
+#endif
@@ -0,0 +1,123 @@
+#pragma once
+#ifndef STOREDEVENT_H
+#define STOREDEVENT_H
+
+#include <cstddef>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Event.h"
+
+namespace glb
+{
+    /**
+     * Events up to this size are stored inline without a heap allocation.
+     * Large enough for all events defined by the library.
+     */
+    constexpr size_t INLINE_EVENT_SIZE = 64;
+
+    /**
+     * @brief Owns an event of any type by value
+     *
+     * A small-buffer container for polymorphic events. Events that fit
+     * into INLINE_EVENT_SIZE bytes and are nothrow-move-constructible are
+     * constructed in an internal buffer. Larger events fall back to a
+     * heap allocation, which is counted by getHeapAllocationCount().
+     *
+     * StoredEvents can be moved, which move-constructs the contained event
+     * at the new location.
+     */
+    class StoredEvent
+    {
+    public:
+        template<typename T>
+        static constexpr bool fitsInline = sizeof(T) <= INLINE_EVENT_SIZE
+                                           && alignof(T) <= alignof(std::max_align_t)
+                                           && std::is_nothrow_move_constructible_v<T>;
+
+        template<typename T, std::enable_if_t<Event::isEventType<std::decay_t<T>>, int> = 0>
+        explicit StoredEvent(T&& e)
+        {
+            using Type = std::decay_t<T>;
+
+            if constexpr (fitsInline<Type>)
+            {
+                event = new (&storage) Type(std::forward<T>(e));
+                relocate = [](void* dst, Event* src) noexcept -> Event* {
+                    auto* srcEvent = static_cast<Type*>(src);
+                    Event* result = new (dst) Type(std::move(*srcEvent));
+                    srcEvent->~Type();
+                    return result;
+                };
+            }
+            else
+            {
+                event = new Type(std::forward<T>(e));
+                heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        StoredEvent(StoredEvent&& other) noexcept
+            :
+            relocate(other.relocate)
+        {
+            if (relocate != nullptr && other.event != nullptr) {
+                event = relocate(&storage, other.event);
+            }
+            else {
+                event = other.event;
+            }
+            other.event = nullptr;
+        }
+
+        StoredEvent(const StoredEvent&) = delete;
+        StoredEvent& operator=(const StoredEvent&) = delete;
+        StoredEvent& operator=(StoredEvent&&) noexcept = delete;
+
+        ~StoredEvent()
+        {
+            if (event == nullptr) return;
+
+            if (relocate != nullptr) {
+                event->~Event();
+            }
+            else {
+                delete event;
+            }
+        }
+
+        [[nodiscard]]
+        auto get() noexcept -> Event& {
+            return *event;
+        }
+
+        [[nodiscard]]
+        auto get() const noexcept -> const Event& {
+            return *event;
+        }
+
+        /**
+         * @return size_t The number of events that were too large to be
+         *                stored inline since program start
+         */
+        [[nodiscard]]
+        static auto getHeapAllocationCount() noexcept -> size_t {
+            return heapAllocationCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Move-constructs the event at src into dst and destroys src.
+        // nullptr if the event is heap-allocated.
+        using RelocateFunc = Event*(*)(void* dst, Event* src) noexcept;
+
+        Event* event{ nullptr };
+        RelocateFunc relocate{ nullptr };
+        alignas(std::max_align_t) std::byte storage[INLINE_EVENT_SIZE];
+
+        static inline std::atomic<size_t> heapAllocationCount{ 0 };
+    };
+} // namespace glb
+
+#endif
@@ -0,0 +1,166 @@
+#pragma once
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <optional>
+#include <functional>
+
+#include "../Clock.h"
+
+namespace glb
+{
+    /**
+     * @brief Identifies a timer scheduled with a TimerWheel
+     *
+     * Ids are never reused, so a stale id can't cancel another timer.
+     */
+    using TimerId = uint64_t;
+
+    constexpr TimerId INVALID_TIMER_ID = 0;
+
+    /**
+     * @brief A hierarchical timer wheel
+     *
+     * Time is divided into ticks of a fixed resolution. Timers are sorted
+     * into four levels of 256 slots each. Level 0 holds timers that expire
+     * within the next 256 ticks, one slot per tick. Every higher level
+     * covers a range 256 times larger. A timer of a higher level is moved
+     * down once the lower level has wrapped around to its slot. With the
+     * default resolution of one millisecond, timers up to about 49 days are
+     * placed directly. Timers that are even further in the future are
+     * moved down multiple times.
+     *
+     * Scheduling and cancelling a timer take constant time, as does every
+     * tick, regardless of the number of pending timers. Timers are linked
+     * into their slot by index. Nodes are recycled, so the wheel only
+     * allocates while the number of concurrently pending timers grows.
+     *
+     * Timers never fire early, but up to one tick late.
+     *
+     * Thread safe. Callbacks are called by advance() without holding the
+     * internal lock, so they may schedule and cancel timers.
+     */
+    class TimerWheel
+    {
+    public:
+        static constexpr uint32_t LEVEL_BITS = 8;
+        static constexpr uint32_t SLOTS_PER_LEVEL = 1 << LEVEL_BITS;
+        static constexpr uint32_t LEVEL_COUNT = 4;
+
+        /**
+         * @brief Create a timer wheel with a resolution of one millisecond
+         */
+        TimerWheel();
+        explicit TimerWheel(Clock::duration resolution);
+
+        /**
+         * @brief Schedule a callback
+         *
+         * @param Clock::time_point deadline The earliest time at which the
+         *                                   callback is called
+         * @param Clock::duration period If greater than zero, the callback
+         *                               is called repeatedly with this
+         *                               period after the deadline. Rounded
+         *                               up to whole ticks.
+         *
+         * @return TimerId Can be used to cancel the timer
+         */
+        auto schedule(Clock::time_point deadline,
+                      Clock::duration period,
+                      std::function<void()> callback) -> TimerId;
+
+        /**
+         * @brief Cancel a pending timer
+         *
+         * A callback that is already being called by advance() on another
+         * thread still returns normally.
+         *
+         * @return bool True if the timer was pending, false if it has
+         *              already expired or been cancelled
+         */
+        bool cancel(TimerId id);
+
+        /**
+         * @brief Call the callbacks of all timers that have expired
+         *
+         * @return size_t Number of callbacks called
+         */
+        auto advance(Clock::time_point now) -> size_t;
+
+        /**
+         * @return std::optional<Clock::time_point> The time at which
+         *         advance() should be called next. Never later than the
+         *         earliest deadline, but may be earlier if timers have to be
+         *         moved down a level. Empty if no timer is pending.
+         */
+        [[nodiscard]]
+        auto getNextDeadline() const -> std::optional<Clock::time_point>;
+
+        /**
+         * @return size_t Number of pending timers
+         */
+        [[nodiscard]]
+        auto size() const -> size_t;
+
+    private:
+        static constexpr uint32_t NIL = UINT32_MAX;
+        static constexpr uint32_t SLOT_MASK = SLOTS_PER_LEVEL - 1;
+        static constexpr uint32_t WORD_COUNT = SLOTS_PER_LEVEL / 64;
+
+        using Callback = std::shared_ptr<const std::function<void()>>;
+
+        struct Node
+        {
+            Node() {} // GCC and Clang can't handle default ctors in nested structs
+
+            uint32_t prev{ NIL };
+            uint32_t next{ NIL };
+            uint32_t generation{ 0 };
+
+            // Index into slots, NIL if the node is free
+            uint32_t slot{ NIL };
+
+            uint64_t deadline{ 0 };
+            uint64_t period{ 0 };
+            Callback callback;
+        };
+
+        auto toTick(Clock::time_point time) const noexcept -> uint64_t;
+        auto toTimePoint(uint64_t tick) const noexcept -> Clock::time_point;
+
+        void insert(uint32_t node);
+        void unlink(uint32_t node);
+        void release(uint32_t node);
+        void cascade(uint32_t level);
+        void expire(uint32_t slot);
+
+        auto getNextWorkTick() const noexcept -> uint64_t;
+        auto findNextOccupied(uint32_t level, uint32_t fromSlot) const noexcept -> std::optional<uint32_t>;
+
+        const Clock::time_point epoch;
+        const Clock::duration resolution;
+
+        mutable std::mutex lock;
+
+        // The last tick that has been processed
+        uint64_t currentTick{ 0 };
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> freeNodes;
+        size_t pendingCount{ 0 };
+
+        // The first node of every slot of every level, and a bit per slot
+        // that is set if the slot is not empty
+        uint32_t slots[LEVEL_COUNT * SLOTS_PER_LEVEL];
+        uint64_t occupied[LEVEL_COUNT][WORD_COUNT]{};
+
+        // Collected under the lock, called without it
+        std::vector<Callback> expired;
+    };
+} // namespace glb
+
+#endif
@@ -0,0 +1,51 @@
+#include "FileCache.h"
+
+#include <fstream>
+#include <iterator>
+
+
+
+namespace
+{
+	auto toKey(const fs::path& file) -> std::string
+	{
+		return file.lexically_normal().string();
+	}
+}
+
+
+
+void glb::FileCache::prefetch(const std::vector<fs::path>& paths)
+{
+	for (const auto& path : paths)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) continue;
+
+		std::string contents{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+		std::lock_guard guard(lock);
+		files[toKey(path)] = std::move(contents);
+	}
+}
+
+auto glb::FileCache::take(const fs::path& file) -> std::optional<std::string>
+{
+	std::lock_guard guard(lock);
+
+	auto it = files.find(toKey(file));
+	if (it == files.end()) {
+		return std::nullopt;
+	}
+
+	std::string contents = std::move(it->second);
+	files.erase(it);
+
+	return contents;
+}
+
+void glb::FileCache::clear()
+{
+	std::lock_guard guard(lock);
+	files.clear();
+}
@@ -0,0 +1,86 @@
+#include "FrameLimiter.h"
+
+#include <cmath>
+#include <algorithm>
+#include <thread>
+
+
+
+void glb::FrameLimiter::setTargetFrameRate(double framesPerSecond) noexcept
+{
+	if (framesPerSecond <= 0.0)
+	{
+		setTargetFrameTime(Clock::duration::zero());
+		return;
+	}
+
+	setTargetFrameTime(std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(1.0 / framesPerSecond)
+	));
+}
+
+void glb::FrameLimiter::setTargetFrameTime(Clock::duration frameTime) noexcept
+{
+	targetFrameTime.store(std::max(frameTime, Clock::duration::zero()).count(),
+						  std::memory_order_relaxed);
+}
+
+auto glb::FrameLimiter::getSleepOvershootEstimate() -> Clock::duration
+{
+	return sleepEstimate - std::chrono::duration_cast<Clock::duration>(SLEEP_STEP);
+}
+
+void glb::FrameLimiter::waitForNextFrame()
+{
+	const Clock::duration frameTime = getTargetFrameTime();
+	const auto now = Clock::now();
+	if (frameTime == Clock::duration::zero() || !hasFrameStart)
+	{
+		frameStart = now;
+		hasFrameStart = true;
+		return;
+	}
+
+	const auto deadline = frameStart + frameTime;
+	if (now >= deadline)
+	{
+		// Late frames are caught up by the following ones unless the
+		// schedule is lost entirely
+		frameStart = now - deadline > frameTime ? now : deadline;
+		return;
+	}
+
+	preciseSleepUntil(deadline);
+	frameStart = deadline;
+}
+
+void glb::FrameLimiter::preciseSleepUntil(Clock::time_point deadline)
+{
+	auto now = Clock::now();
+	while (deadline - now > sleepEstimate)
+	{
+		std::this_thread::sleep_for(SLEEP_STEP);
+		const auto woken = Clock::now();
+		updateSleepEstimate(woken - now);
+		now = woken;
+	}
+
+	// The last stretch is shorter than the scheduler can reliably sleep
+	while (Clock::now() < deadline) {}
+}
+
+void glb::FrameLimiter::updateSleepEstimate(Clock::duration measured)
+{
+	const double ns = std::chrono::duration<double, std::nano>(measured).count();
+	const double delta = ns - sleepMean;
+	sleepMean += ESTIMATE_WEIGHT * delta;
+	sleepVariance = (1.0 - ESTIMATE_WEIGHT) * (sleepVariance + ESTIMATE_WEIGHT * delta * delta);
+
+	// Two standard deviations above the mean, so that a sleep step rarely
+	// takes longer than expected
+	const double estimate = sleepMean + 2.0 * std::sqrt(sleepVariance);
+	sleepEstimate = std::max(
+		std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(estimate)),
+		std::chrono::duration_cast<Clock::duration>(SLEEP_STEP)
+	);
+}
@@ -0,0 +1,202 @@
+#include "FrameStatistics.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+
+
+namespace
+{
+	auto toMilliseconds(glb::Clock::duration d) -> double
+	{
+		return std::chrono::duration<double, std::milli>(d).count();
+	}
+}
+
+
+
+auto glb::computeFrameDurationStatistics(std::vector<Clock::duration>& samples)
+	-> FrameDurationStatistics
+{
+	FrameDurationStatistics result;
+	if (samples.empty()) return result;
+
+	Clock::duration sum{ 0 };
+	for (const auto d : samples) {
+		sum += d;
+	}
+	std::sort(samples.begin(), samples.end());
+
+	auto percentile = [&](double p) {
+		return samples[static_cast<size_t>(p * static_cast<double>(samples.size() - 1))];
+	};
+
+	result.mean = sum / static_cast<Clock::rep>(samples.size());
+	result.p95 = percentile(0.95);
+	result.p99 = percentile(0.99);
+	result.max = samples.back();
+
+	return result;
+}
+
+void glb::FrameStatistics::setEnabled(bool enable) noexcept
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+void glb::FrameStatistics::setHistorySize(size_t frames)
+{
+	std::lock_guard guard(lock);
+
+	historySize = std::max<size_t>(frames, 1);
+	history.assign(historySize, {});
+	next = 0;
+	count = 0;
+	presentIntervalSum = Clock::duration::zero();
+}
+
+void glb::FrameStatistics::setHitchFactor(double factor)
+{
+	std::lock_guard guard(lock);
+	hitchFactor = factor;
+}
+
+auto glb::FrameStatistics::getStats() -> FrameStats
+{
+	const std::vector<FrameTiming> frames = getHistory();
+
+	FrameStats stats;
+	stats.frameCount = frames.size();
+
+	std::vector<Clock::duration> samples;
+	samples.reserve(frames.size());
+
+	for (const auto& f : frames) samples.push_back(f.cpuFrameTime);
+	stats.cpuFrameTime = computeFrameDurationStatistics(samples);
+	samples.clear();
+	for (const auto& f : frames) samples.push_back(f.swapTime);
+	stats.swapTime = computeFrameDurationStatistics(samples);
+	samples.clear();
+	for (const auto& f : frames) samples.push_back(f.fenceWaitTime);
+	stats.fenceWaitTime = computeFrameDurationStatistics(samples);
+	samples.clear();
+	for (const auto& f : frames) samples.push_back(f.presentInterval);
+	stats.presentInterval = computeFrameDurationStatistics(samples);
+
+	stats.hitchCount = static_cast<size_t>(std::count_if(
+		frames.begin(), frames.end(), [](const auto& f) { return f.hitch; }
+	));
+
+	std::lock_guard guard(lock);
+	stats.totalFrameCount = totalFrameCount;
+	stats.totalHitchCount = totalHitchCount;
+
+	return stats;
+}
+
+auto glb::FrameStatistics::getLastFrame() -> FrameTiming
+{
+	std::lock_guard guard(lock);
+
+	if (count == 0) return {};
+	return history[(next + historySize - 1) % historySize];
+}
+
+auto glb::FrameStatistics::getHistory() -> std::vector<FrameTiming>
+{
+	std::lock_guard guard(lock);
+
+	std::vector<FrameTiming> result;
+	result.reserve(count);
+	const size_t first = (next + historySize - count) % historySize;
+	for (size_t i = 0; i < count; i++) {
+		result.push_back(history[(first + i) % historySize]);
+	}
+
+	return result;
+}
+
+void glb::FrameStatistics::reset()
+{
+	std::lock_guard guard(lock);
+
+	next = 0;
+	count = 0;
+	presentIntervalSum = Clock::duration::zero();
+	totalFrameCount = 0;
+	totalHitchCount = 0;
+	hasLastSwap = false;
+}
+
+void glb::FrameStatistics::writeCsv(const fs::path& path)
+{
+	std::ofstream file(path);
+	if (!file) {
+		throw std::runtime_error("Unable to open frame statistics file " + path.string());
+	}
+
+	file << "frame,cpu_frame_time_ms,swap_time_ms,fence_wait_time_ms,present_interval_ms,hitch\n";
+	file << std::fixed << std::setprecision(3);
+	for (const auto& f : getHistory())
+	{
+		file << f.frame << ','
+			 << toMilliseconds(f.cpuFrameTime) << ','
+			 << toMilliseconds(f.swapTime) << ','
+			 << toMilliseconds(f.fenceWaitTime) << ','
+			 << toMilliseconds(f.presentInterval) << ','
+			 << (f.hitch ? 1 : 0) << '\n';
+	}
+}
+
+void glb::FrameStatistics::recordFrame(
+	Clock::time_point swapBegin,
+	Clock::time_point swapEnd,
+	Clock::duration fenceWaitTime,
+	Clock::time_point nextFrameStart)
+{
+	if (!isEnabled()) return;
+
+	std::lock_guard guard(lock);
+
+	// The first frame has no predecessor to measure against
+	const Clock::time_point previous = lastSwapEnd;
+	const Clock::time_point start = frameStart;
+	const bool hasPrevious = hasLastSwap;
+	lastSwapEnd = swapEnd;
+	frameStart = nextFrameStart;
+	hasLastSwap = true;
+	if (!hasPrevious) return;
+
+	if (history.size() != historySize) {
+		history.assign(historySize, {});
+	}
+
+	FrameTiming timing;
+	timing.frame = totalFrameCount++;
+	timing.cpuFrameTime = swapBegin - start;
+	timing.swapTime = swapEnd - swapBegin;
+	timing.fenceWaitTime = fenceWaitTime;
+	timing.presentInterval = swapEnd - previous;
+
+	// Compare against the mean of the frames before this one
+	if (count >= MIN_FRAMES_FOR_HITCH_DETECTION)
+	{
+		const auto mean = presentIntervalSum / static_cast<Clock::rep>(count);
+		timing.hitch = timing.presentInterval > mean * hitchFactor;
+		if (timing.hitch) {
+			totalHitchCount++;
+		}
+	}
+
+	if (count == historySize) {
+		presentIntervalSum -= history[next].presentInterval;
+	}
+	else {
+		count++;
+	}
+	presentIntervalSum += timing.presentInterval;
+	history[next] = timing;
+	next = (next + 1) % historySize;
+}
@@ -0,0 +1,199 @@
+#include "GpuProfiler.h"
+
+#include <chrono>
+
+#include "Window.h"
+
+
+
+void glb::GpuProfiler::setEnabled(bool enable)
+{
+	// The query functions are not loaded without timer query support
+	if (enable && !(Window::isOpen() && (GLEW_VERSION_3_3 || GLEW_ARB_timer_query))) {
+		return;
+	}
+
+	enabled = enable;
+}
+
+void glb::GpuProfiler::beginZone(const char* name)
+{
+	if (!enabled) return;
+
+	FrameQueries& frame = frames[currentFrame];
+	const uint32_t zone = findZone(name);
+	openZones.push_back(static_cast<uint32_t>(frame.zones.size()));
+	frame.zones.push_back({ zone, writeTimestamp(), 0 });
+}
+
+void glb::GpuProfiler::endZone()
+{
+	// The zone has begun while the profiler was disabled
+	if (openZones.empty()) return;
+
+	FrameQueries& frame = frames[currentFrame];
+	frame.zones[openZones.back()].endQuery = writeTimestamp();
+	openZones.pop_back();
+}
+
+auto glb::GpuProfiler::getZoneStatistics() -> std::vector<GpuZoneStatistics>
+{
+	std::vector<GpuZoneStatistics> result;
+	std::vector<Clock::duration> samples;
+	for (const Zone& zone : zones)
+	{
+		if (zone.history.empty()) continue;
+
+		samples = zone.history;
+		GpuZoneStatistics& stats = result.emplace_back();
+		stats.name = zone.name;
+		stats.frame = zone.frame;
+		stats.last = zone.last;
+		stats.statistics = computeFrameDurationStatistics(samples);
+	}
+
+	return result;
+}
+
+auto glb::GpuProfiler::getDroppedFrameCount() -> uint64_t
+{
+	return droppedFrameCount;
+}
+
+void glb::GpuProfiler::reset()
+{
+	for (FrameQueries& frame : frames) {
+		clear(frame);
+	}
+	zones.clear();
+	openZones.clear();
+	frameNumber = 0;
+	droppedFrameCount = 0;
+}
+
+void glb::GpuProfiler::endFrame()
+{
+	// Zones that are still open end with the frame
+	while (!openZones.empty()) {
+		endZone();
+	}
+
+	FrameQueries& current = frames[currentFrame];
+	current.pending = !current.zones.empty();
+	current.frame = frameNumber++;
+	currentFrame = (currentFrame + 1) % FRAME_LATENCY;
+
+	// Read back finished frames, the oldest first. The GPU finishes
+	// frames in order, so the first unfinished one ends the search.
+	for (uint32_t i = 0; i < FRAME_LATENCY; i++)
+	{
+		FrameQueries& frame = frames[(currentFrame + i) % FRAME_LATENCY];
+		if (!frame.pending) continue;
+		if (!readBack(frame)) break;
+		clear(frame);
+	}
+
+	// The oldest frame's queries are reused now. Don't wait for them.
+	FrameQueries& next = frames[currentFrame];
+	if (next.pending)
+	{
+		droppedFrameCount++;
+		clear(next);
+	}
+}
+
+void glb::GpuProfiler::destroyQueries()
+{
+	for (FrameQueries& frame : frames)
+	{
+		clear(frame);
+		frame.queries.clear();
+	}
+	openZones.clear();
+	enabled = false;
+}
+
+auto glb::GpuProfiler::findZone(const char* name) -> uint32_t
+{
+	for (size_t i = 0; i < zones.size(); i++)
+	{
+		if (zones[i].name == name) {
+			return static_cast<uint32_t>(i);
+		}
+	}
+
+	Zone& zone = zones.emplace_back();
+	zone.name = name;
+	zone.history.reserve(ZONE_HISTORY_SIZE);
+
+	return static_cast<uint32_t>(zones.size() - 1);
+}
+
+auto glb::GpuProfiler::writeTimestamp() -> uint32_t
+{
+	FrameQueries& frame = frames[currentFrame];
+	if (frame.usedQueries == frame.queries.size())
+	{
+		frame.queries.emplace_back();
+		glGenQueries(1, frame.queries.back().assign());
+	}
+
+	const uint32_t index = frame.usedQueries++;
+	glQueryCounter(*frame.queries[index], GL_TIMESTAMP);
+
+	return index;
+}
+
+bool glb::GpuProfiler::readBack(FrameQueries& frame)
+{
+	// Timestamps are written in order, so the earlier queries are
+	// available if the last one is
+	GLint available{ GL_FALSE };
+	glGetQueryObjectiv(*frame.queries[frame.usedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (available == GL_FALSE) return false;
+
+	for (const TimedZone& timed : frame.zones)
+	{
+		GLuint64 begin{ 0 };
+		GLuint64 end{ 0 };
+		glGetQueryObjectui64v(*frame.queries[timed.beginQuery], GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(*frame.queries[timed.endQuery], GL_QUERY_RESULT, &end);
+
+		Zone& zone = zones[timed.zone];
+		if (!zone.touched)
+		{
+			zone.touched = true;
+			zone.accumulated = Clock::duration::zero();
+			touchedZones.push_back(timed.zone);
+		}
+		if (end > begin) {
+			zone.accumulated += std::chrono::nanoseconds(end - begin);
+		}
+	}
+
+	// One result per zone and frame
+	for (const uint32_t index : touchedZones)
+	{
+		Zone& zone = zones[index];
+		zone.touched = false;
+		zone.frame = frame.frame;
+		zone.last = zone.accumulated;
+		if (zone.history.size() < ZONE_HISTORY_SIZE) {
+			zone.history.push_back(zone.accumulated);
+		}
+		else {
+			zone.history[zone.next] = zone.accumulated;
+		}
+		zone.next = (zone.next + 1) % ZONE_HISTORY_SIZE;
+	}
+	touchedZones.clear();
+
+	return true;
+}
+
+void glb::GpuProfiler::clear(FrameQueries& frame)
+{
+	frame.usedQueries = 0;
+	frame.zones.clear();
+	frame.pending = false;
+}
@@ -0,0 +1,115 @@
+#include "InputState.h"
+
+#include <cstring>
+
+
+
+bool glb::InputSnapshot::isKeyPressed(eKey key) const noexcept
+{
+	const auto index = static_cast<size_t>(key);
+	return index < KEY_COUNT && keys.test(index);
+}
+
+bool glb::InputSnapshot::isMouseButtonPressed(eMouseButton button) const noexcept
+{
+	const auto index = static_cast<size_t>(button);
+	return index < MOUSE_BUTTON_COUNT && mouseButtons.test(index);
+}
+
+
+
+auto glb::InputState::getSnapshot() noexcept -> InputSnapshot
+{
+	uint64_t words[WORD_COUNT];
+	while (true)
+	{
+		const Buffer& buffer = buffers[current.load(std::memory_order_acquire)];
+
+		const uint32_t before = buffer.sequence.load(std::memory_order_acquire);
+		if (before & 1) continue;
+
+		for (size_t i = 0; i < WORD_COUNT; i++) {
+			words[i] = buffer.words[i].load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (buffer.sequence.load(std::memory_order_relaxed) == before) break;
+	}
+
+	InputSnapshot result;
+	std::memcpy(&result, words, sizeof(InputSnapshot));
+	return result;
+}
+
+bool glb::InputState::isKeyPressed(eKey key) noexcept
+{
+	return getSnapshot().isKeyPressed(key);
+}
+
+bool glb::InputState::isMouseButtonPressed(eMouseButton button) noexcept
+{
+	return getSnapshot().isMouseButtonPressed(button);
+}
+
+auto glb::InputState::getCursorPos() noexcept -> vec2
+{
+	return getSnapshot().cursorPos;
+}
+
+void glb::InputState::setKey(eKey key, bool pressed) noexcept
+{
+	const auto index = static_cast<size_t>(key);
+	if (index < InputSnapshot::KEY_COUNT) {
+		working.keys.set(index, pressed);
+	}
+}
+
+void glb::InputState::setMouseButton(eMouseButton button, bool pressed) noexcept
+{
+	const auto index = static_cast<size_t>(button);
+	if (index < InputSnapshot::MOUSE_BUTTON_COUNT) {
+		working.mouseButtons.set(index, pressed);
+	}
+}
+
+void glb::InputState::setCursorPos(vec2 pos) noexcept
+{
+	working.cursorDelta += pos - working.cursorPos;
+	working.cursorPos = pos;
+}
+
+void glb::InputState::resetCursorPos(vec2 pos) noexcept
+{
+	working.cursorPos = pos;
+}
+
+void glb::InputState::addScroll(vec2 offset) noexcept
+{
+	working.scrollDelta += offset;
+}
+
+void glb::InputState::publish() noexcept
+{
+	working.frame++;
+
+	uint64_t words[WORD_COUNT]{};
+	std::memcpy(words, &working, sizeof(InputSnapshot));
+
+	// Write the buffer that readers are not directed to
+	const uint32_t next = current.load(std::memory_order_relaxed) ^ 1;
+	Buffer& buffer = buffers[next];
+
+	const uint32_t seq = buffer.sequence.load(std::memory_order_relaxed);
+	buffer.sequence.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	for (size_t i = 0; i < WORD_COUNT; i++) {
+		buffer.words[i].store(words[i], std::memory_order_relaxed);
+	}
+	buffer.sequence.store(seq + 2, std::memory_order_release);
+
+	current.store(next, std::memory_order_release);
+
+	// Deltas are per snapshot
+	working.cursorDelta = vec2(0.0f);
+	working.scrollDelta = vec2(0.0f);
+}
@@ -5,17 +5,48 @@
 
 
 void glb::OpenGlLazyInit::addLazyInitializer(std::function<void(void)> func)
+{
+	addLazyInitializer({}, std::move(func));
+}
+
+void glb::OpenGlLazyInit::addLazyInitializer(
+	std::function<void(void)> prepare,
+	std::function<void(void)> glInit)
 {
 	if (!Window::isContextCreated())
-		lazyInitializers.push_back(std::move(func));
+	{
+		std::lock_guard guard(lock);
+		lazyInitializers.push_back({ std::move(prepare), std::move(glInit) });
+	}
 	else
-		std::invoke(func);
+	{
+		if (prepare) std::invoke(prepare);
+		if (glInit) std::invoke(glInit);
+	}
+}
+
+auto glb::OpenGlLazyInit::getInitializers() -> std::vector<Initializer>
+{
+	std::lock_guard guard(lock);
+	return lazyInitializers;
+}
+
+void glb::OpenGlLazyInit::prepareAll(const std::vector<Initializer>& initializers)
+{
+	for (const auto& init : initializers)
+		if (init.prepare) std::invoke(init.prepare);
 }
 
-void glb::OpenGlLazyInit::initAll()
+void glb::OpenGlLazyInit::initAll(size_t preparedCount)
 {
-	for (const auto& func : lazyInitializers)
-		std::invoke(func);
+	// Initializers may add more initializers, which are called immediately
+	const auto initializers = getInitializers();
+	for (size_t i = 0; i < initializers.size(); i++)
+	{
+		const auto& init = initializers[i];
+		if (i >= preparedCount && init.prepare) std::invoke(init.prepare);
+		if (init.glInit) std::invoke(init.glInit);
+	}
 }
 
 
@@ -0,0 +1,95 @@
+#include "MainLoop.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "Profiler.h"
+#include "Window.h"
+
+
+
+namespace
+{
+	// Resets a flag when the scope is left, even by an exception
+	struct ResetOnExit
+	{
+		bool& flag;
+		~ResetOnExit() { flag = false; }
+	};
+}
+
+
+
+void glb::MainLoop::run(const MainLoopCreateInfo& info)
+{
+	if (!Window::isOpen()) {
+		throw std::runtime_error("MainLoop::run() requires an open window");
+	}
+	if (running) {
+		throw std::runtime_error("MainLoop::run() is already running");
+	}
+	if (info.tickRate <= 0.0) {
+		throw std::runtime_error("MainLoop tick rate must be positive");
+	}
+
+	const auto tick = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(1.0 / info.tickRate)
+	);
+	const double tickSeconds = std::chrono::duration<double>(tick).count();
+	const auto maxAccumulated = tick * std::max<uint32_t>(info.maxTicksPerFrame, 1);
+
+	running = true;
+	ResetOnExit resetRunning{ running };
+	stopRequested = false;
+	tickCount = 0;
+	droppedTime = Clock::duration::zero();
+
+	Clock::duration accumulator{ 0 };
+	auto lastFrame = Clock::now();
+	while (!stopRequested)
+	{
+		Window::pollEvents();
+		if (!Window::isOpen()) {
+			break;
+		}
+
+		const auto now = Clock::now();
+		accumulator += now - lastFrame;
+		lastFrame = now;
+
+		// Don't try to catch up with more time than a frame can simulate
+		if (accumulator > maxAccumulated)
+		{
+			droppedTime += accumulator - maxAccumulated;
+			accumulator = maxAccumulated;
+		}
+
+		while (accumulator >= tick)
+		{
+			GLB_PROFILE_ZONE("MainLoop update");
+			if (info.update) info.update(tickSeconds);
+			accumulator -= tick;
+			tickCount++;
+		}
+
+		// The update hook may have closed the window or stopped the loop
+		if (!Window::isOpen() || stopRequested) {
+			break;
+		}
+
+		{
+			GLB_PROFILE_ZONE("MainLoop render");
+			if (info.clearBackBuffer) Window::clear();
+			if (info.render) info.render(static_cast<double>(accumulator.count()) / tick.count());
+		}
+
+		Window::swapBuffers();
+
+		if (info.idle) info.idle();
+	}
+}
+
+void glb::MainLoop::stop() noexcept
+{
+	stopRequested = true;
+}
@@ -0,0 +1,236 @@
+#include "Profiler.h"
+
+#include <iomanip>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+
+
+namespace
+{
+	constexpr size_t EVENTS_PER_CHUNK = 4096;
+
+	struct ProfileEvent
+	{
+		const char* name;
+		glb::Clock::time_point begin;
+		glb::Clock::duration duration;
+	};
+
+	struct Chunk
+	{
+		ProfileEvent events[EVENTS_PER_CHUNK];
+		std::atomic<Chunk*> next{ nullptr };
+	};
+
+	void deleteChunks(Chunk* chunk)
+	{
+		while (chunk != nullptr)
+		{
+			Chunk* next = chunk->next.load(std::memory_order_relaxed);
+			delete chunk;
+			chunk = next;
+		}
+	}
+
+	/**
+	 * Only the owning thread appends events. Other threads may read the
+	 * first `count` events, which are published with a release store.
+	 */
+	struct ThreadBuffer
+	{
+		ThreadBuffer(uint32_t threadId, size_t maxEvents)
+			: threadId(threadId), maxEvents(maxEvents), first(new Chunk), tail(first)
+		{}
+
+		ThreadBuffer(const ThreadBuffer&) = delete;
+		ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+		~ThreadBuffer() {
+			deleteChunks(first);
+		}
+
+		const uint32_t threadId;
+		std::string name; // Guarded by registryLock
+		size_t maxEvents;
+
+		Chunk* const first;
+		Chunk* tail;
+		size_t tailSize{ 0 };
+		std::atomic<size_t> count{ 0 };
+	};
+
+	// Buffers are never destroyed, so the trace can contain the zones of
+	// threads that have already exited
+	std::mutex registryLock;
+	std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+
+	thread_local ThreadBuffer* localBuffer{ nullptr };
+
+	auto getLocalBuffer(size_t maxEvents) -> ThreadBuffer&
+	{
+		if (localBuffer == nullptr)
+		{
+			std::lock_guard guard(registryLock);
+			const auto threadId = static_cast<uint32_t>(threadBuffers.size() + 1);
+			threadBuffers.push_back(std::make_unique<ThreadBuffer>(threadId, maxEvents));
+			localBuffer = threadBuffers.back().get();
+		}
+
+		return *localBuffer;
+	}
+
+	void writeJsonString(std::ostream& os, const char* str)
+	{
+		os << '"';
+		for (; *str != '\0'; str++)
+		{
+			const char c = *str;
+			if (c == '"' || c == '\\') {
+				os << '\\' << c;
+			}
+			else if (static_cast<unsigned char>(c) < 0x20) {
+				os << ' ';
+			}
+			else {
+				os << c;
+			}
+		}
+		os << '"';
+	}
+
+	// Chrome traces use microseconds. Writes the nanoseconds as decimals.
+	void writeMicroseconds(std::ostream& os, int64_t ns)
+	{
+		if (ns < 0)
+		{
+			os << '-';
+			ns = -ns;
+		}
+		os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000;
+	}
+
+	auto toNanoseconds(glb::Clock::duration d) -> int64_t
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+	}
+}
+
+
+
+void glb::Profiler::setEnabled(bool enable) noexcept
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+void glb::Profiler::setMaxEventsPerThread(size_t count) noexcept
+{
+	maxEventsPerThread.store(count, std::memory_order_relaxed);
+}
+
+void glb::Profiler::setThreadName(std::string name)
+{
+	ThreadBuffer& buffer = getLocalBuffer(maxEventsPerThread.load(std::memory_order_relaxed));
+
+	std::lock_guard guard(registryLock);
+	buffer.name = std::move(name);
+}
+
+auto glb::Profiler::getDroppedEventCount() noexcept -> uint64_t
+{
+	return droppedEventCount.load(std::memory_order_relaxed);
+}
+
+void glb::Profiler::clear()
+{
+	std::lock_guard guard(registryLock);
+
+	for (auto& buffer : threadBuffers)
+	{
+		deleteChunks(buffer->first->next.load(std::memory_order_relaxed));
+		buffer->first->next.store(nullptr, std::memory_order_relaxed);
+		buffer->tail = buffer->first;
+		buffer->tailSize = 0;
+		buffer->maxEvents = maxEventsPerThread.load(std::memory_order_relaxed);
+		buffer->count.store(0, std::memory_order_release);
+	}
+	droppedEventCount.store(0, std::memory_order_relaxed);
+}
+
+void glb::Profiler::writeChromeTrace(const fs::path& path)
+{
+	std::ofstream file(path);
+	if (!file) {
+		throw std::runtime_error("Unable to open profiler trace file " + path.string());
+	}
+
+	file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+	// Only new threads and names are blocked while the lock is held
+	std::lock_guard guard(registryLock);
+
+	bool firstEvent = true;
+	auto separate = [&]() {
+		if (!firstEvent) file << ",\n";
+		firstEvent = false;
+	};
+
+	for (const auto& buffer : threadBuffers)
+	{
+		if (!buffer->name.empty())
+		{
+			separate();
+			file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+				 << ",\"args\":{\"name\":";
+			writeJsonString(file, buffer->name.c_str());
+			file << "}}";
+		}
+
+		const size_t count = buffer->count.load(std::memory_order_acquire);
+		const Chunk* chunk = buffer->first;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (i > 0 && i % EVENTS_PER_CHUNK == 0) {
+				chunk = chunk->next.load(std::memory_order_acquire);
+			}
+			const ProfileEvent& event = chunk->events[i % EVENTS_PER_CHUNK];
+
+			separate();
+			file << "{\"name\":";
+			writeJsonString(file, event.name);
+			file << ",\"cat\":\"glb\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+			writeMicroseconds(file, toNanoseconds(event.begin.time_since_epoch()));
+			file << ",\"dur\":";
+			writeMicroseconds(file, toNanoseconds(event.duration));
+			file << '}';
+		}
+	}
+
+	file << "\n]}\n";
+}
+
+void glb::Profiler::record(const char* name, Clock::time_point begin, Clock::time_point end)
+{
+	ThreadBuffer& buffer = getLocalBuffer(maxEventsPerThread.load(std::memory_order_relaxed));
+
+	const size_t count = buffer.count.load(std::memory_order_relaxed);
+	if (count >= buffer.maxEvents)
+	{
+		droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	if (buffer.tailSize == EVENTS_PER_CHUNK)
+	{
+		Chunk* chunk = new Chunk;
+		buffer.tail->next.store(chunk, std::memory_order_release);
+		buffer.tail = chunk;
+		buffer.tailSize = 0;
+	}
+
+	buffer.tail->events[buffer.tailSize++] = { name, begin, end - begin };
+	buffer.count.store(count + 1, std::memory_order_release);
+}
@@ -8,6 +8,9 @@
 #include <filesystem>
 namespace fs = std::filesystem;
 
+#include "FileCache.h"
+#include "Profiler.h"
+
 
 
 GLuint glb::ShaderLoader::loadProgram(
@@ -17,6 +20,8 @@ GLuint glb::ShaderLoader::loadProgram(
 	const std::string& tese,
 	const std::string& geom)
 {
+	GLB_PROFILE_ZONE("ShaderLoader::loadProgram");
+
 	std::vector<GLuint> shaders;
 
     // Vertex shader - must be present
@@ -58,16 +63,20 @@ GLuint glb::ShaderLoader::loadShader(const std::string& path, GLuint glShaderEnu
 	// Read code from file
 	std::string shaderCode;
 
-	std::ifstream file(path);
-	if (file.is_open())
+	if (auto prefetched = FileCache::take(path)) {
+		shaderCode = std::move(*prefetched);
+	}
+	else
 	{
+		std::ifstream file(path);
+		if (!file.is_open())
+			throw std::runtime_error("Only pass valid filepaths to ShaderLoader::loadShader()!");
+
 		std::stringstream code;
 		code << file.rdbuf();
 		shaderCode = code.str();
 		file.close();
 	}
-    else
-        throw std::runtime_error("Only pass valid filepaths to ShaderLoader::loadShader()!");
 
     internal::ShaderPreCompiler preCompiler;
     preCompiler.processShaderCode(shaderCode, path);
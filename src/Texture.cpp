@@ -8,6 +8,9 @@ namespace fs = std::filesystem;
 
 #include <IL/il.h>
 
+#include "FileCache.h"
+#include "Profiler.h"
+
 
 
 glb::Texture::Texture()
@@ -66,6 +69,8 @@ auto glb::Texture::operator*() const noexcept -> GLuint
 
 void glb::Texture::loadImage(const std::string& imagePath)
 {
+    GLB_PROFILE_ZONE("Texture::loadImage");
+
     if (!fs::is_regular_file(imagePath))
     {
         loadColor(UNINITIALIZED_COLOR);
@@ -81,7 +86,15 @@ void glb::Texture::loadImage(const std::string& imagePath)
 	ilEnable(IL_ORIGIN_SET);
 	ilOriginFunc(IL_ORIGIN_LOWER_LEFT); // match image origin with OpenGL�s
 
-	success = ilLoadImage(imagePath.c_str());
+	// Decode prefetched files from memory if DevIL knows the type
+	const auto prefetched = FileCache::take(imagePath);
+	const ILenum type = prefetched ? ilTypeFromExt(imagePath.c_str()) : IL_TYPE_UNKNOWN;
+	if (type != IL_TYPE_UNKNOWN) {
+		success = ilLoadL(type, prefetched->data(), static_cast<ILuint>(prefetched->size()));
+	}
+	else {
+		success = ilLoadImage(imagePath.c_str());
+	}
 	if (!success)
 	{
 		ilDeleteImage(imageID);
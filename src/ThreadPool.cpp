@@ -0,0 +1,123 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+
+
+glb::ThreadPool::ThreadPool(uint32_t threadCount)
+{
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (uint32_t i = 0; i < threadCount; i++) {
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+	for (uint32_t i = 0; i < threadCount; i++) {
+		threads.emplace_back(&ThreadPool::work, this, i);
+	}
+}
+
+glb::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(sleepLock);
+		stopRequested = true;
+	}
+	wakeCondition.notify_all();
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+void glb::ThreadPool::submit(std::function<void()> task)
+{
+	const uint32_t index = currentPool == this
+		? currentQueue
+		: nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+
+	// Count the task before it can be popped, so that the decrement of
+	// a worker never precedes the increment and wraps the counter
+	pendingTasks++;
+	{
+		std::lock_guard lock(queues[index]->lock);
+		queues[index]->tasks.push_back(std::move(task));
+	}
+
+	// Workers announce that they're going to sleep before they check
+	// for pending tasks, so one of the two sides always sees the other
+	if (sleepingWorkers.load() > 0)
+	{
+		std::lock_guard lock(sleepLock);
+		wakeCondition.notify_one();
+	}
+}
+
+auto glb::ThreadPool::getThreadCount() const noexcept -> uint32_t
+{
+	return static_cast<uint32_t>(threads.size());
+}
+
+bool glb::ThreadPool::isWorkerThread() const noexcept
+{
+	return currentPool == this;
+}
+
+void glb::ThreadPool::work(uint32_t index)
+{
+	currentPool = this;
+	currentQueue = index;
+
+	std::function<void()> task;
+	while (true)
+	{
+		if (tryPop(index, task) || trySteal(index, task))
+		{
+			pendingTasks--;
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		// Only stop once all tasks have been executed
+		if (stopRequested) break;
+
+		sleepingWorkers++;
+		{
+			std::unique_lock lock(sleepLock);
+			wakeCondition.wait(lock, [this] {
+				return pendingTasks.load() > 0 || stopRequested;
+			});
+		}
+		sleepingWorkers--;
+	}
+}
+
+bool glb::ThreadPool::tryPop(uint32_t index, std::function<void()>& result)
+{
+	WorkQueue& queue = *queues[index];
+	std::lock_guard lock(queue.lock);
+	if (queue.tasks.empty()) return false;
+
+	result = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	return true;
+}
+
+bool glb::ThreadPool::trySteal(uint32_t thief, std::function<void()>& result)
+{
+	for (size_t i = 1; i < queues.size(); i++)
+	{
+		WorkQueue& victim = *queues[(thief + i) % queues.size()];
+		std::lock_guard lock(victim.lock);
+		if (!victim.tasks.empty())
+		{
+			result = std::move(victim.tasks.front());
+			victim.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -5,21 +5,28 @@ using namespace std::chrono;
 template<typename TimeType>
 glb::Timer<TimeType>::Timer()
     :
-	last_reset(time_point_cast<TimeType>(ClockType::now()))
+	last_reset(ClockType::now())
 {
 }
 
 template<typename TimeType>
-auto glb::Timer<TimeType>::reset() noexcept -> uint32_t
+auto glb::Timer<TimeType>::reset() noexcept -> uint64_t
 {
-	auto time = duration_cast<TimeType>(ClockType::now() - last_reset);
-	last_reset = time_point_cast<TimeType>(ClockType::now());
+	const auto now = ClockType::now();
+	const auto time = duration_cast<TimeType>(now - last_reset);
+	last_reset = now;
 
-	return static_cast<uint32_t>(time.count());
+	return static_cast<uint64_t>(time.count());
 }
 
 template<typename TimeType>
-auto glb::Timer<TimeType>::duration() const noexcept -> uint32_t
+auto glb::Timer<TimeType>::duration() const noexcept -> uint64_t
 {
-	return static_cast<uint32_t>(duration_cast<TimeType>(ClockType::now() - last_reset).count());
+	return static_cast<uint64_t>(duration_cast<TimeType>(ClockType::now() - last_reset).count());
+}
+
+template<typename TimeType>
+auto glb::Timer<TimeType>::elapsed() const noexcept -> Clock::duration
+{
+	return ClockType::now() - last_reset;
 }
@@ -2,20 +2,142 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <fstream>
+#include <future>
+#include <map>
 
 #include <IL/il.h>
 
 #include "event/EventHandler.h"
+#include "FileCache.h"
+#include "FrameLimiter.h"
+#include "FrameStatistics.h"
+#include "GpuProfiler.h"
+#include "InputState.h"
 #include "LazyInitializer.h"
+#include "Profiler.h"
 
 
 
-void initGLFW()
+namespace
+{
+	struct ContextVersion
+	{
+		int major;
+		int minor;
+	};
+
+	bool operator<(ContextVersion a, ContextVersion b)
+	{
+		return a.major < b.major || (a.major == b.major && a.minor < b.minor);
+	}
+
+	// All desktop OpenGL versions, the newest first
+	constexpr ContextVersion OPENGL_VERSIONS[]{
+		{ 4, 6 }, { 4, 5 }, { 4, 4 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 4, 0 },
+		{ 3, 3 }, { 3, 2 }, { 3, 1 }, { 3, 0 },
+		{ 2, 1 }, { 2, 0 },
+		{ 1, 5 }, { 1, 4 }, { 1, 3 }, { 1, 2 }, { 1, 1 }, { 1, 0 },
+	};
+
+	// The context creation API and version that a context has been
+	// created with, for visible and for headless windows. Kept when the
+	// window is closed.
+	struct CachedContext
+	{
+		int api;
+		ContextVersion version;
+	};
+
+	constexpr const char* CONTEXT_CACHE_FILE_TAG = "glb-context-cache-2";
+
+	std::map<bool, CachedContext> contextVersionCache;
+	bool contextVersionCacheChanged{ false };
+
+	void loadContextVersionCache(const fs::path& path)
+	{
+		// Files in another format are ignored and overwritten later
+		std::ifstream file(path);
+		std::string tag;
+		if (!(file >> tag) || tag != CONTEXT_CACHE_FILE_TAG) return;
+
+		bool headless{ false };
+		CachedContext context{ 0, { 0, 0 } };
+		while (file >> headless >> context.api >> context.version.major >> context.version.minor) {
+			contextVersionCache.try_emplace(headless, context);
+		}
+	}
+
+	void storeContextVersionCache(const fs::path& path)
+	{
+		// The cache only saves time, so a file that can't be written is
+		// not an error
+		std::ofstream file(path);
+		file << CONTEXT_CACHE_FILE_TAG << '\n';
+		for (const auto& [headless, context] : contextVersionCache)
+		{
+			file << headless << ' ' << context.api << ' '
+				 << context.version.major << ' ' << context.version.minor << '\n';
+		}
+	}
+
+	struct BackgroundPhase
+	{
+		const char* name;
+		std::future<glb::Clock::duration> duration;
+	};
+
+	template<typename F>
+	auto runInBackground(const char* name, F func) -> BackgroundPhase
+	{
+		return { name, std::async(std::launch::async, [name, func]() {
+			GLB_PROFILE_ZONE(name);
+			const auto begin = glb::Clock::now();
+			func();
+			return glb::Clock::now() - begin;
+		}) };
+	}
+
+	template<typename F>
+	void timePhase(std::vector<glb::StartupPhaseTiming>& timings, const char* name, F func)
+	{
+		GLB_PROFILE_ZONE(name);
+		const auto begin = glb::Clock::now();
+		func();
+		timings.push_back({ name, glb::Clock::now() - begin, false });
+	}
+}
+
+
+
+int toGlfwCursorMode(glb::Window::CursorMode mode)
+{
+	switch (mode)
+	{
+	case glb::Window::CursorMode::hidden:
+		return GLFW_CURSOR_HIDDEN;
+	case glb::Window::CursorMode::disabled:
+		return GLFW_CURSOR_DISABLED;
+	default:
+		return GLFW_CURSOR_NORMAL;
+	}
+}
+
+void initGLFW(bool headless)
 {
 	static bool initialized = false;
 	if (initialized) return;
 	initialized = true;
 
+#ifdef GLFW_PLATFORM_NULL
+	// GLFW 3.4 can create windows without a display server
+	if (headless) {
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	}
+#else
+	(void)headless;
+#endif
+
 	// Init GLFW
 	if (glfwInit() == 0)
 	{
@@ -26,14 +148,24 @@ void initGLFW()
 	std::cout << "--- GLFW initialized.\n";
 }
 
-void initGLEW()
+void initGLEW(bool headless)
 {
 	static bool initialized = false;
 	if (initialized) return;
 	initialized = true;
 
 	glewExperimental = true;
-	if (glewInit() != GLEW_OK)
+	GLenum result = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+	// GLEW built for GLX queries the X display after it has loaded the
+	// OpenGL functions, which fails for offscreen contexts
+	if (headless && result == GLEW_ERROR_NO_GLX_DISPLAY) {
+		result = GLEW_OK;
+	}
+#else
+	(void)headless;
+#endif
+	if (result != GLEW_OK)
 	{
 		std::cout << "Failed to initialize GLEW!\n";
 		throw std::runtime_error("Failed to initialize GLEW!\n");
@@ -43,86 +175,106 @@ void initGLEW()
 	std::cout << "--- GLEW initialized.\n";
 }
 
-GLFWwindow* createWindow(const glb::Window::WindowCreateInfo& data)
+GLFWwindow* tryCreateContext(const glb::Window::WindowCreateInfo& data,
+							 int contextApi,
+							 ContextVersion version)
+{
+	glfwWindowHint(GLFW_SAMPLES, data.sampleCount);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version.major);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version.minor);
+	// Profiles only exist since OpenGL 3.2
+	glfwWindowHint(GLFW_OPENGL_PROFILE, version < ContextVersion{ 3, 2 }
+		? GLFW_OPENGL_ANY_PROFILE
+		: GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextApi);
+
+	glfwWindowHint(GLFW_RESIZABLE, data.resizable);
+    glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, data.transparent);
+	glfwWindowHint(GLFW_VISIBLE, !data.headless);
+	glfwWindowHint(GLFW_FOCUSED, !data.headless);
+
+	// Enable to have window always on top
+	// glfwWindowHint(GLFW_FLOATING, GLFW_TRUE);
+
+	return glfwCreateWindow(
+        static_cast<int>(data.width),
+        static_cast<int>(data.height),
+        data.windowName.c_str(),
+        nullptr,
+        nullptr
+    );
+}
+
+GLFWwindow* probeContextVersions(const glb::Window::WindowCreateInfo& data,
+								 int contextApi,
+								 ContextVersion& createdVersion)
 {
-	// Create window
-	int currentMajorVersion{ glb::DEFAULT_OPENGL_VERSION_MAJOR };
-	int currentMinorVersion{ glb::DEFAULT_OPENGL_VERSION_MINOR };
-
-    GLFWwindow* window{ nullptr };
-	while (window == nullptr
-		&& currentMajorVersion >= data.minOpenGlVersionMajor
-		&& currentMinorVersion >= data.minOpenGlVersionMinor)
+	const ContextVersion minVersion{ data.minOpenGlVersionMajor, data.minOpenGlVersionMinor };
+	for (const ContextVersion& version : OPENGL_VERSIONS)
 	{
-		glfwWindowHint(GLFW_SAMPLES, data.sampleCount);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, data.minOpenGlVersionMajor);
-		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, data.minOpenGlVersionMinor);
-		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-		glfwWindowHint(GLFW_RESIZABLE, data.resizable);
-        glfwWindowHint(GLFW_TRANSPARENT_FRAMEBUFFER, data.transparent);
-		glfwWindowHint(GLFW_VISIBLE, true);
-		glfwWindowHint(GLFW_FOCUSED, true);
-
-		// Enable to have window always on top
-		// glfwWindowHint(GLFW_FLOATING, GLFW_TRUE);
-
-		window = glfwCreateWindow(
-            static_cast<int>(data.width),
-            static_cast<int>(data.height),
-            data.windowName.c_str(),
-            nullptr,
-            nullptr
-        );
-		if (window == nullptr)
+		if (version < minVersion) break;
+
+		if (GLFWwindow* window = tryCreateContext(data, contextApi, version))
 		{
-			// Calculate new version
-			currentMinorVersion--;
-			if (currentMinorVersion < 0)
-				currentMajorVersion--;
+			createdVersion = version;
+			return window;
+		}
+	}
 
-			// Silence warnings
-			constexpr int _6 = 6;
-			constexpr int _5 = 5;
-			constexpr int _3 = 3;
+	return nullptr;
+}
+
+GLFWwindow* createWindow(const glb::Window::WindowCreateInfo& data)
+{
+	const ContextVersion minVersion{ data.minOpenGlVersionMajor, data.minOpenGlVersionMinor };
+	GLFWwindow* window{ nullptr };
+	ContextVersion version{ 0, 0 };
+
+	// Only try the context that worked last time. All others are probed
+	// again only if it fails.
+	const auto cached = contextVersionCache.find(data.headless);
+	if (cached != contextVersionCache.end() && !(cached->second.version < minVersion))
+	{
+		version = cached->second.version;
+		window = tryCreateContext(data, cached->second.api, version);
+	}
 
-			switch (currentMajorVersion)
+	if (window == nullptr)
+	{
+		// OSMesa renders into a buffer in main memory. Newer Mesa versions
+		// only provide offscreen rendering through EGL.
+		const std::vector<int> contextApis = data.headless
+			? std::vector<int>{ GLFW_OSMESA_CONTEXT_API, GLFW_EGL_CONTEXT_API }
+			: std::vector<int>{ GLFW_NATIVE_CONTEXT_API };
+		for (const int api : contextApis)
+		{
+			window = probeContextVersions(data, api, version);
+			if (window != nullptr)
 			{
-			case 4:
-				if (currentMinorVersion < 0)
-					currentMinorVersion = _6;
-				break;
-			case 3:
-				if (currentMinorVersion < 0)
-					currentMinorVersion = _3;
-				break;
-			case 2:
-				if (currentMinorVersion < 0)
-					currentMinorVersion = 1;
-				break;
-			case 1:
-				if (currentMinorVersion < 0)
-					currentMinorVersion = _5;
-				break;
-			case 0:
+				contextVersionCache[data.headless] = { api, version };
+				contextVersionCacheChanged = true;
 				break;
 			}
 		}
 	}
 
+	if (window != nullptr)
+	{
+		std::cout << "--- OpenGL context created with version " << version.major
+				  << "." << version.minor << "\n";
+	}
+
 	// Window is still nullptr if the specified major and minor version could not be provided
 	if (window == nullptr)
 	{
 		std::cout << "The specified OpenGL requirements major-version = "
                   << data.minOpenGlVersionMajor << " and minor-version "
-                  << data.minOpenGlVersionMinor << " could not be met.";
+                  << data.minOpenGlVersionMinor << " could not be met"
+                  << (data.headless ? " by an offscreen context." : ".");
 		glfwTerminate();
 		throw std::runtime_error("Window creation failed: OpenGL version not supported.");
 	}
 
-	std::cout << "--- OpenGL context created with version " << currentMajorVersion
-              << "." << currentMinorVersion << "\n";
-
     return window;
 }
 
@@ -131,43 +283,51 @@ void glb::Window::initCallbacks()
 	glfwSetKeyCallback(window, [](GLFWwindow*, int key, int /*scancode*/, int action, int mods) {
         if (action == static_cast<int>(eInputAction::press))
         {
-            EventHandler::notify(
-                std::make_unique<KeyPressEvent>(
-                    static_cast<eKey>(key),
-                    static_cast<eKeyMod>(mods)
+            InputState::setKey(static_cast<eKey>(key), true);
+            EventHandler::notify(KeyPressEvent(
+                static_cast<eKey>(key),
+                static_cast<eKeyMod>(mods)
             ));
         }
         if (action == static_cast<int>(eInputAction::release))
         {
-            EventHandler::notify(
-                std::make_unique<KeyReleaseEvent>(
-                    static_cast<eKey>(key),
-                    static_cast<eKeyMod>(mods)
+            InputState::setKey(static_cast<eKey>(key), false);
+            EventHandler::notify(KeyReleaseEvent(
+                static_cast<eKey>(key),
+                static_cast<eKeyMod>(mods)
             ));
         }
 	});
 
 	glfwSetMouseButtonCallback(window, [](GLFWwindow*, int button, int action, int mods) {
+        // Use the cursor position of this frame, not of the last snapshot
+        const vec2 cursorPos = InputState::working.cursorPos;
         if (action == static_cast<int>(eInputAction::press))
         {
-            EventHandler::notify(
-                std::make_unique<MouseButtonPressEvent>(
-                    static_cast<eMouseButton>(button),
-                    static_cast<eKeyMod>(mods)
+            InputState::setMouseButton(static_cast<eMouseButton>(button), true);
+            EventHandler::notify(MouseButtonPressEvent(
+                static_cast<eMouseButton>(button),
+                static_cast<eKeyMod>(mods),
+                cursorPos
             ));
         }
         if (action == static_cast<int>(eInputAction::release))
         {
-            EventHandler::notify(
-                std::make_unique<MouseButtonReleaseEvent>(
-                    static_cast<eMouseButton>(button),
-                    static_cast<eKeyMod>(mods)
+            InputState::setMouseButton(static_cast<eMouseButton>(button), false);
+            EventHandler::notify(MouseButtonReleaseEvent(
+                static_cast<eMouseButton>(button),
+                static_cast<eKeyMod>(mods),
+                cursorPos
             ));
         }
 	});
 
 	glfwSetCursorPosCallback(window, [](GLFWwindow*, double xpos, double ypos) {
-		EventHandler::notify(std::make_unique<MouseMoveEvent>(vec2(xpos, ypos)));
+		InputState::setCursorPos(vec2(xpos, ypos));
+
+		// The motion is reported by pollEvents()
+		if (cursorDisabled && accumulateMouseMotion) return;
+		EventHandler::notify(MouseMoveEvent(vec2(xpos, ypos)));
 	});
 
     glfwSetWindowCloseCallback(window, [](GLFWwindow*) {
@@ -177,11 +337,12 @@ void glb::Window::initCallbacks()
     glfwSetFramebufferSizeCallback(window, [](GLFWwindow*, int width, int height) {
         ivec2 oldSize = sizePixels;
         sizePixels = ivec2(width, height);
-        EventHandler::notify(std::make_unique<WindowResizeEvent>(oldSize, sizePixels));
+        EventHandler::notify(WindowResizeEvent(oldSize, sizePixels));
     });
 
     glfwSetScrollCallback(window, [](GLFWwindow*, double xOffset, double yOffset) {
-        EventHandler::notify(std::make_unique<MouseScrollEvent>(vec2(xOffset, yOffset)));
+        InputState::addScroll(vec2(xOffset, yOffset));
+        EventHandler::notify(MouseScrollEvent(vec2(xOffset, yOffset), InputState::working.cursorPos));
     });
 
 	std::cout << "--- Event handler initialized.\n";
@@ -190,18 +351,54 @@ void glb::Window::initCallbacks()
 void glb::Window::create(const WindowCreateInfo& data)
 {
     if (_isOpen) return;
+	GLB_PROFILE_ZONE("Window::create");
+	setMaxFramesInFlight(data.maxFramesInFlight);
+
+	std::vector<StartupPhaseTiming> timings;
+	const auto createBegin = Clock::now();
+
+	// Start the work that doesn't need an OpenGL context. Prepare
+	// functions may load images, so DevIL is initialized first.
+	const auto lazyInitializers = OpenGlLazyInit::getInitializers();
+	BackgroundPhase backgroundPhases[]{
+		runInBackground("File prefetch", [&data]() { FileCache::prefetch(data.prefetchFiles); }),
+		runInBackground("DevIL init and lazy initializer preparation", [&lazyInitializers]() {
+			ilInit();
+			OpenGlLazyInit::prepareAll(lazyInitializers);
+		}),
+	};
 
 	// First, init GLFW
-	initGLFW();
+	timePhase(timings, "GLFW init", [&]() { initGLFW(data.headless); });
 
     // Create and init window
-    window = createWindow(data);
+	timePhase(timings, "Context creation", [&]() {
+		if (!data.contextVersionCacheFile.empty()) {
+			loadContextVersionCache(data.contextVersionCacheFile);
+		}
+		window = createWindow(data);
+		if (contextVersionCacheChanged && !data.contextVersionCacheFile.empty()) {
+			storeContextVersionCache(data.contextVersionCacheFile);
+		}
+		contextVersionCacheChanged = false;
+	});
+    headless = data.headless;
 	glfwSetInputMode(window, GLFW_STICKY_KEYS,
                      data.inputMode & InputModeFlags::stickyKeys);
 	glfwSetInputMode(window, GLFW_STICKY_MOUSE_BUTTONS,
                      data.inputMode & InputModeFlags::stickyMouseButtons);
-	glfwSetInputMode(window, GLFW_CURSOR,
-                     static_cast<int>(data.cursorMode));
+	glfwSetInputMode(window, GLFW_CURSOR, toGlfwCursorMode(data.cursorMode));
+
+    cursorDisabled = data.cursorMode == CursorMode::disabled;
+    accumulateMouseMotion = data.accumulateMouseMotion;
+    if (cursorDisabled && data.rawMouseMotion && glfwRawMouseMotionSupported()) {
+        glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+    }
+
+    // Start the cursor deltas at the actual position
+    dvec2 cursorPos;
+    glfwGetCursorPos(window, &cursorPos.x, &cursorPos.y);
+    InputState::resetCursorPos(vec2(cursorPos));
 
     // Vsync must be set after the window is created, idk why
 	makeContextCurrent();
@@ -211,27 +408,43 @@ void glb::Window::create(const WindowCreateInfo& data)
 	else {
 		glfwSwapInterval(SWAP_INTERVAL_VSYNC_DISABLED); // Interval == 0 -> disable vsync
     }
+	FrameLimiter::setTargetFrameRate(data.maxFrameRate);
 
 	// Initialize additional resources
 	// GLEW must be initialized after an OpenGL context (aka. the window) has been created.
-	initGLEW();
+	timePhase(timings, "GLEW init", [&]() { initGLEW(data.headless); });
     contextCreated = true;
 
+	// glFenceSync is not loaded on contexts that lack sync objects, e.g.
+	// old or software contexts
+	fencesSupported = GLEW_VERSION_3_2 || GLEW_ARB_sync;
+	if (!fencesSupported && data.maxFramesInFlight != 0) {
+		std::cout << "--- Sync objects are not supported, frames in flight are not limited.\n";
+	}
+	setMaxFramesInFlight(data.maxFramesInFlight);
+
     if (data.useEventHandler == true) {
-        EventHandler::init();
+        timePhase(timings, "Event handler init", [&]() { EventHandler::init(data.eventHandlerInfo); });
     }
+    EventHandler::setCoalescing<MouseMoveEvent>(data.coalesceMouseMoveEvents);
+    EventHandler::setCoalescing<MouseScrollEvent>(data.coalesceMouseScrollEvents);
 	initCallbacks();
-	ilInit();
+
+	timePhase(timings, "Background init wait", [&]() {
+		for (auto& phase : backgroundPhases) {
+			timings.push_back({ phase.name, phase.duration.get(), true });
+		}
+	});
 
 	// Call lazy initializers
-	OpenGlLazyInit::initAll();
+	timePhase(timings, "Lazy initializers", [&]() { OpenGlLazyInit::initAll(lazyInitializers.size()); });
 
     // Poll events once to make the window responsive
     pollEvents();
 
     sizePixels = ivec2(data.width, data.height);
     _isOpen = true;
-    EventHandler::notify(std::make_unique<WindowCreateEvent>());
+    EventHandler::notify(WindowCreateEvent());
 	std::cout << "--- Window created successfully.\n";
 
     // Resize the window to the actual framebuffer size.
@@ -241,6 +454,15 @@ void glb::Window::create(const WindowCreateInfo& data)
     ivec2 framebufferSize;
     glfwGetFramebufferSize(window, &framebufferSize.x, &framebufferSize.y);
     resize(framebufferSize);
+
+	timings.push_back({ "Total", Clock::now() - createBegin, false });
+	for (const auto& phase : timings)
+	{
+		std::cout << "--- Startup phase " << phase.name << ": "
+				  << std::chrono::duration<double, std::milli>(phase.duration).count() << " ms"
+				  << (phase.background ? " (background)" : "") << "\n";
+	}
+	startupTimings = std::move(timings);
 }
 
 void glb::Window::close()
@@ -248,8 +470,12 @@ void glb::Window::close()
     if (!_isOpen) return;
 
     _isOpen = false;
-    EventHandler::notify(std::make_unique<WindowCloseEvent>());
+    EventHandler::notify(WindowCloseEvent());
+    frameFences.clear();
+    GpuProfiler::destroyQueries();
     glfwDestroyWindow(window);
+    EventHandler::terminate();
+    FileCache::clear();
 }
 
 auto glb::Window::getGlfwWindow() -> GLFWwindow*
@@ -259,12 +485,78 @@ auto glb::Window::getGlfwWindow() -> GLFWwindow*
 
 void glb::Window::swapBuffers()
 {
+	GpuProfiler::endFrame();
+
+	const auto swapBegin = Clock::now();
 	glfwSwapBuffers(window);
+	const auto swapEnd = Clock::now();
+
+	const Clock::duration fenceWaitTime = waitForFramesInFlight();
+	FrameLimiter::waitForNextFrame();
+	FrameStatistics::recordFrame(swapBegin, swapEnd, fenceWaitTime, Clock::now());
+
+	LatencyTracker::recordFrame();
+}
+
+void glb::Window::setMaxFramesInFlight(uint32_t frames)
+{
+	if (frames > MAX_FRAMES_IN_FLIGHT) {
+		throw std::runtime_error("At most " + std::to_string(MAX_FRAMES_IN_FLIGHT) + " frames can be in flight");
+	}
+
+	maxFramesInFlight = fencesSupported ? frames : 0;
+	if (maxFramesInFlight == 0) {
+		frameFences.clear();
+	}
+}
+
+auto glb::Window::getStartupTimings() -> std::vector<StartupPhaseTiming>
+{
+	return startupTimings;
+}
+
+auto glb::Window::getMaxFramesInFlight() -> uint32_t
+{
+	return maxFramesInFlight;
+}
+
+auto glb::Window::waitForFramesInFlight() -> Clock::duration
+{
+	constexpr GLuint64 WAIT_TIMEOUT_NS = 100'000'000;
+
+	if (maxFramesInFlight == 0) {
+		return Clock::duration::zero();
+	}
+
+	frameFences.emplace_back(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+	const auto begin = Clock::now();
+	while (frameFences.size() > maxFramesInFlight - 1)
+	{
+		GLB_PROFILE_ZONE("Window fence wait");
+
+		GLenum result = GL_TIMEOUT_EXPIRED;
+		while (result == GL_TIMEOUT_EXPIRED) {
+			result = glClientWaitSync(*frameFences.front(), GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT_NS);
+		}
+		frameFences.erase(frameFences.begin());
+	}
+
+	return Clock::now() - begin;
 }
 
 void glb::Window::pollEvents()
 {
     glfwPollEvents();
+
+    // One event per frame, no matter how many samples the mouse delivered
+    const vec2 motion = InputState::working.cursorDelta;
+    if (cursorDisabled && motion != vec2(0.0f)) {
+        EventHandler::notify(MouseMotionEvent(motion, InputState::working.cursorPos));
+    }
+
+    InputState::publish();
+    EventHandler::dispatchEvents();
 }
 
 void glb::Window::clear()
@@ -286,12 +578,18 @@ void glb::Window::resize(ivec2 newSizePixels)
 {
 	glfwSetWindowSize(window, newSizePixels.x, newSizePixels.y);
 
+    // GLFW reallocates an offscreen framebuffer when the context is made
+    // current
+    if (headless) {
+        makeContextCurrent();
+    }
+
     // I was too lazy to extract this piece of code into a function, I just copy-pasted
     // it from initCallbacks(). Appearently, glfwSetWindowSize() does not call my callbacks.
     ivec2 oldSize = sizePixels;
     sizePixels = ivec2(newSizePixels.x, newSizePixels.y);
     updateViewport();
-    EventHandler::notify(std::make_unique<WindowResizeEvent>(oldSize, sizePixels));
+    EventHandler::notify(WindowResizeEvent(oldSize, sizePixels));
 }
 
 bool glb::Window::isOpen()
@@ -304,6 +602,11 @@ bool glb::Window::isContextCreated()
     return contextCreated;
 }
 
+bool glb::Window::isHeadless()
+{
+    return headless;
+}
+
 void glb::Window::makeContextCurrent()
 {
 	glfwMakeContextCurrent(window);
@@ -0,0 +1,196 @@
+#include "event/ActionMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+
+
+glb::ActionMap::ActionMap(uint32_t actionCount)
+	:
+	actionCount(actionCount),
+	table(KEY_COUNT * MOD_COMBINATIONS, NO_ACTION),
+	keyActions(KEY_COUNT, NO_ACTION),
+	activeKeyCount(actionCount, 0),
+	active(actionCount, 0),
+	pressed(actionCount, 0),
+	released(actionCount, 0)
+{
+}
+
+void glb::ActionMap::bind(eKey key, int mods, ActionId action)
+{
+	if (action >= actionCount) {
+		throw std::out_of_range("Action id " + std::to_string(action) + " is out of range");
+	}
+
+	mods &= MOD_MASK;
+	auto it = std::find_if(bindings.begin(), bindings.end(), [&](const KeyBinding& b) {
+		return b.key == key && (b.mods & MOD_MASK) == mods;
+	});
+	if (it != bindings.end()) {
+		it->action = action;
+	}
+	else {
+		bindings.push_back({ key, mods, action });
+	}
+
+	rebuildTable();
+}
+
+void glb::ActionMap::unbind(eKey key, int mods)
+{
+	mods &= MOD_MASK;
+	bindings.erase(
+		std::remove_if(bindings.begin(), bindings.end(), [&](const KeyBinding& b) {
+			return b.key == key && (b.mods & MOD_MASK) == mods;
+		}),
+		bindings.end()
+	);
+
+	rebuildTable();
+}
+
+void glb::ActionMap::setBindings(std::vector<KeyBinding> newBindings)
+{
+	for (const auto& b : newBindings)
+	{
+		if (b.action >= actionCount) {
+			throw std::out_of_range("Action id " + std::to_string(b.action) + " is out of range");
+		}
+	}
+
+	bindings = std::move(newBindings);
+	rebuildTable();
+}
+
+auto glb::ActionMap::getBindings() const noexcept -> const std::vector<KeyBinding>&
+{
+	return bindings;
+}
+
+auto glb::ActionMap::resolve(eKey key, int mods) const noexcept -> ActionId
+{
+	const uint32_t index = getTableIndex(key, mods);
+	return index < table.size() ? table[index] : NO_ACTION;
+}
+
+void glb::ActionMap::handleEvent(const Event& event)
+{
+	// Test the exact type id first, it's much cheaper than a dynamic_cast
+	const EventTypeId type = event.getTypeId();
+	if (type == getEventTypeId<KeyPressEvent>())
+	{
+		const auto& e = static_cast<const KeyPressEvent&>(event);
+		press(e.key, e.mods);
+	}
+	else if (type == getEventTypeId<KeyReleaseEvent>()) {
+		release(static_cast<const KeyReleaseEvent&>(event).key);
+	}
+	else if (type == INVALID_EVENT_TYPE_ID)
+	{
+		// Not passed through the event handler
+		if (auto e = event.to<KeyPressEvent>()) {
+			press(e->key, e->mods);
+		}
+		else if (auto e = event.to<KeyReleaseEvent>()) {
+			release(e->key);
+		}
+	}
+}
+
+void glb::ActionMap::handleEvents(const EventBatch& events)
+{
+	for (const Event* e : events) {
+		handleEvent(*e);
+	}
+}
+
+void glb::ActionMap::clearTransitions() noexcept
+{
+	std::fill(pressed.begin(), pressed.end(), 0);
+	std::fill(released.begin(), released.end(), 0);
+}
+
+auto glb::ActionMap::getActionCount() const noexcept -> uint32_t
+{
+	return actionCount;
+}
+
+bool glb::ActionMap::isActive(ActionId action) const noexcept
+{
+	return action < actionCount && active[action] != 0;
+}
+
+bool glb::ActionMap::wasPressed(ActionId action) const noexcept
+{
+	return action < actionCount && pressed[action] != 0;
+}
+
+bool glb::ActionMap::wasReleased(ActionId action) const noexcept
+{
+	return action < actionCount && released[action] != 0;
+}
+
+auto glb::ActionMap::getActiveStates() const noexcept -> const uint8_t*
+{
+	return active.data();
+}
+
+auto glb::ActionMap::getPressedStates() const noexcept -> const uint8_t*
+{
+	return pressed.data();
+}
+
+auto glb::ActionMap::getReleasedStates() const noexcept -> const uint8_t*
+{
+	return released.data();
+}
+
+auto glb::ActionMap::getTableIndex(eKey key, int mods) noexcept -> uint32_t
+{
+	// Unknown keys are negative and end up out of range
+	return static_cast<uint32_t>(key) * MOD_COMBINATIONS + static_cast<uint32_t>(mods & MOD_MASK);
+}
+
+void glb::ActionMap::rebuildTable()
+{
+	std::fill(table.begin(), table.end(), NO_ACTION);
+	for (const auto& b : bindings)
+	{
+		const uint32_t index = getTableIndex(b.key, b.mods);
+		if (index < table.size()) {
+			table[index] = b.action;
+		}
+	}
+}
+
+void glb::ActionMap::press(eKey key, int mods)
+{
+	const auto keyIndex = static_cast<uint32_t>(key);
+	if (keyIndex >= KEY_COUNT || keyActions[keyIndex] != NO_ACTION) return;
+
+	const ActionId action = table[getTableIndex(key, mods)];
+	if (action == NO_ACTION) return;
+
+	keyActions[keyIndex] = action;
+	if (activeKeyCount[action]++ == 0)
+	{
+		active[action] = 1;
+		pressed[action] = 1;
+	}
+}
+
+void glb::ActionMap::release(eKey key)
+{
+	const auto keyIndex = static_cast<uint32_t>(key);
+	if (keyIndex >= KEY_COUNT || keyActions[keyIndex] == NO_ACTION) return;
+
+	const ActionId action = keyActions[keyIndex];
+	keyActions[keyIndex] = NO_ACTION;
+	if (--activeKeyCount[action] == 0)
+	{
+		active[action] = 0;
+		released[action] = 1;
+	}
+}
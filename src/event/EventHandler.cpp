@@ -1,60 +1,859 @@
 #include "event/EventHandler.h"
 
-#include <thread>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
 
 #include "event/Listener.h"
+#include "Profiler.h"
+
+
+
+namespace
+{
+	inline void cpuRelax() noexcept
+	{
+#if defined(_MSC_VER)
+		_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+} // anonymous namespace
 
 
 
-void glb::EventHandler::init()
+void glb::EventHandler::init(const EventHandlerCreateInfo& info)
 {
-	static bool initialized = false;
-	if (initialized) return;
-	initialized = true;
+	if (synchronousDispatch) return;
+	if (dispatcher.thread.joinable())
+	{
+		// A listener may have stopped the thread from within
+		if (!stopRequested) return;
+		dispatcher.thread.join();
+	}
+	stopRequested = false;
+	spinCount = info.spinCount;
+
+	// The queue must exist before the first producer or the consumer
+	// thread can access it. Producers that passed the running check
+	// before terminate() may still be in notify(). Wait for them before
+	// the old queue is replaced. Nothing else consumes at this point.
+	if (pendingEvents != nullptr)
+	{
+		while (activeProducers.load() != 0)
+		{
+			discardPending();
+			std::this_thread::yield();
+		}
+		discardPending();
+		droppedEventCount += pendingEvents->getDroppedCount();
+	}
+	pendingEvents = std::make_unique<EventQueue>(info.queueCapacity, info.overflowPolicy);
+	currentBatch.reserve(pendingEvents->capacity());
+	collectedEvents.reserve(pendingEvents->capacity());
+
+	// The pool is only accessed by the dispatcher thread, which is not
+	// running at this point
+	if (info.dispatchMode == EventDispatchMode::parallel)
+	{
+		if (workerPool == nullptr) {
+			workerPool = std::make_unique<ThreadPool>(info.workerThreadCount);
+		}
+	}
+	else if (workerPool != nullptr && !workerPool->isWorkerThread()) {
+		workerPool.reset();
+	}
 
-	std::thread notify_thread = std::thread(&EventHandler::run);
-	notify_thread.detach();
+	if (info.dispatchMode == EventDispatchMode::synchronous)
+	{
+		synchronousDispatch = true;
+		consumerThread = std::this_thread::get_id();
+	}
+	else {
+		dispatcher.thread = std::thread(&EventHandler::run);
+	}
+	running.store(true, std::memory_order_release);
 }
 
-void glb::EventHandler::notify(std::unique_ptr<Event> e)
+void glb::EventHandler::terminate()
 {
-	pendingEvents.push(e.release());
+	if (synchronousDispatch)
+	{
+		running.store(false);
+
+		// A listener that terminates is called from the dispatch loop,
+		// which empties the queue anyway
+		if (!dispatching)
+		{
+			dispatchEvents();
+			discardPending();
+		}
+		synchronousDispatch = false;
+		consumerThread = std::thread::id();
+		return;
+	}
+
+	if (!dispatcher.thread.joinable()) return;
+
+	running.store(false);
+	stopRequested = true;
+	wakeDispatcher();
+
+	// Can't join from within the thread itself
+	if (std::this_thread::get_id() != dispatcher.thread.get_id())
+	{
+		dispatcher.thread.join();
+		discardPending();
+
+		// Calls the listeners that still have events in their mailbox
+		if (workerPool != nullptr && !workerPool->isWorkerThread()) {
+			workerPool.reset();
+		}
+	}
 }
 
-void glb::EventHandler::add(Listener& l)
+void glb::EventHandler::add(Listener& l, const ListenerDispatchInfo& info)
 {
-	listeners.push_back(&l);
+	auto entry = std::make_shared<ListenerEntry>();
+	entry->listener = &l;
+	entry->info = info;
+
+	modifyTable([&](DispatchTable& t) {
+		if (info.executor != nullptr)
+		{
+			entry->executor = info.executor->queue;
+			if (std::find(t.executors.begin(), t.executors.end(), entry->executor) == t.executors.end()) {
+				t.executors.push_back(entry->executor);
+			}
+		}
+		else if (info.affinity == ListenerAffinity::pool)
+		{
+			// Listeners of the same serial group share an actor
+			if (info.serialGroup != 0)
+			{
+				for (const auto& a : t.actors)
+				{
+					if (a->serialGroup == info.serialGroup)
+					{
+						entry->actor = a;
+						break;
+					}
+				}
+			}
+			if (entry->actor == nullptr)
+			{
+				entry->actor = std::make_shared<DispatchActor>();
+				entry->actor->serialGroup = info.serialGroup;
+				t.actors.push_back(entry->actor);
+			}
+		}
+
+		t.listeners.push_back(entry);
+	});
+
+	// Actors and executors may be shared with the table that is still in
+	// use. The listener only becomes a member once the table that
+	// contains it has been published, so that nothing calls it before it
+	// is fully registered.
+	if (entry->executor != nullptr)
+	{
+		std::lock_guard executorLock(entry->executor->lock);
+		entry->executor->members.push_back(&l);
+	}
+	else if (entry->actor != nullptr)
+	{
+		std::lock_guard actorLock(entry->actor->lock);
+		entry->actor->members.push_back(&l);
+	}
 }
 
 void glb::EventHandler::remove(Listener& l)
 {
-	for (size_t i = 0; i < listeners.size(); i++)
+	std::shared_ptr<ListenerEntry> entry;
+	modifyTable([&](DispatchTable& t) {
+		auto it = std::find_if(t.listeners.begin(), t.listeners.end(),
+							   [&l](const auto& e) { return e->listener == &l; });
+		if (it == t.listeners.end()) return;
+
+		entry = std::move(*it);
+		t.listeners.erase(it);
+
+		const auto& actor = entry->actor;
+		if (actor != nullptr
+			&& std::none_of(t.listeners.begin(), t.listeners.end(),
+							[&actor](const auto& e) { return e->actor == actor; }))
+		{
+			t.actors.erase(std::find(t.actors.begin(), t.actors.end(), actor));
+		}
+
+		const auto& executor = entry->executor;
+		if (executor != nullptr
+			&& std::none_of(t.listeners.begin(), t.listeners.end(),
+							[&executor](const auto& e) { return e->executor == executor; }))
+		{
+			t.executors.erase(std::find(t.executors.begin(), t.executors.end(), executor));
+		}
+	});
+
+	if (entry == nullptr) return;
+
+	// The dispatcher may still use an older table. A listener that is
+	// called on the dispatcher thread and removes itself or another
+	// listener can't wait for the dispatcher.
+	const bool onDispatcher = consumerThread.load() == std::this_thread::get_id();
+	entry->retire(!onDispatcher);
+
+	if (entry->executor != nullptr)
+	{
+		ExecutorQueue& queue = *entry->executor;
+		std::unique_lock lock(queue.lock);
+		std::replace(queue.members.begin(), queue.members.end(), &l, static_cast<Listener*>(nullptr));
+		queue.idle.wait(lock, [&] {
+			return queue.current != &l || queue.owner == std::this_thread::get_id();
+		});
+		if (!queue.draining)
+		{
+			queue.members.erase(
+				std::remove(queue.members.begin(), queue.members.end(), nullptr),
+				queue.members.end()
+			);
+		}
+		return;
+	}
+
+	if (entry->actor == nullptr) return;
+
+	DispatchActor& actor = *entry->actor;
+	std::unique_lock lock(actor.lock);
+	std::replace(actor.members.begin(), actor.members.end(), &l, static_cast<Listener*>(nullptr));
+	actor.idle.wait(lock, [&] {
+		return actor.current != &l || actor.currentThread == std::this_thread::get_id();
+	});
+	if (!actor.scheduled)
+	{
+		actor.members.erase(
+			std::remove(actor.members.begin(), actor.members.end(), nullptr),
+			actor.members.end()
+		);
+	}
+}
+
+void glb::EventHandler::dispatchEvents()
+{
+	if (!synchronousDispatch
+		|| consumerThread.load() != std::this_thread::get_id()
+		|| dispatching)
 	{
-		if (listeners[i] == &l)
+		return;
+	}
+
+	timers.advance(Clock::now());
+	dispatchPending();
+}
+
+bool glb::EventHandler::cancelTimer(TimerId timer)
+{
+	return timers.cancel(timer);
+}
+
+auto glb::EventHandler::addSubscriber(EventTypeId type, std::function<void(const Event&)> callback)
+	-> EventSubscription
+{
+	auto sub = std::make_shared<Subscriber>();
+	sub->callback = std::move(callback);
+
+	modifyTable([&](DispatchTable& t) {
+		if (t.subscribers.size() <= type) {
+			t.subscribers.resize(type + 1);
+		}
+		sub->id = nextSubscriberId++;
+		t.subscribers[type].push_back(sub);
+	});
+
+	return EventSubscription(type, sub->id);
+}
+
+void glb::EventHandler::removeSubscriber(EventTypeId type, uint64_t id)
+{
+	std::shared_ptr<Subscriber> sub;
+	modifyTable([&](DispatchTable& t) {
+		auto& list = t.subscribers.at(type);
+		auto it = std::find_if(list.begin(), list.end(),
+							   [id](const auto& s) { return s->id == id; });
+		if (it != list.end())
 		{
-			listenerLock.lock();
-			listeners.erase(listeners.begin() + i);
-			listenerLock.unlock();
-			break;
+			sub = std::move(*it);
+			list.erase(it);
 		}
+	});
+
+	if (sub != nullptr) {
+		sub->retire(consumerThread.load() != std::this_thread::get_id());
 	}
 }
 
+void glb::EventHandler::setCoalesceFunc(EventTypeId type, CoalesceFunc func)
+{
+	modifyTable([&](DispatchTable& t) {
+		if (t.coalesceFuncs.size() <= type) {
+			t.coalesceFuncs.resize(type + 1, nullptr);
+		}
+		t.coalesceFuncs[type] = func;
+	});
+}
+
+auto glb::EventHandler::getDroppedEventCount() -> size_t
+{
+	if (pendingEvents == nullptr) return 0;
+
+	return pendingEvents->getDroppedCount() + droppedEventCount.load();
+}
+
+auto glb::EventHandler::getHeapAllocatedEventCount() -> size_t
+{
+	return StoredEvent::getHeapAllocationCount();
+}
+
 void glb::EventHandler::run()
 {
+	consumerThread = std::this_thread::get_id();
+	Profiler::setThreadName("glb event handler");
+
 	while (true)
 	{
-		if (!pendingEvents.empty())
+		timers.advance(Clock::now());
+
+		while (!pendingEvents->empty())
+		{
+			GLB_PROFILE_ZONE("EventHandler::run");
+			dispatchPending();
+		}
+
+		// Only stop once all pending events have been dispatched
+		if (stopRequested) break;
+
+		waitForEvents();
+	}
+}
+
+void glb::EventHandler::discardPending()
+{
+	// Producers that passed the running check just before terminate()
+	// may still have enqueued events. The caller is the only consumer.
+	while (!pendingEvents->empty())
+	{
+		pendingEvents->pop();
+		droppedEventCount++;
+	}
+}
+
+void glb::EventHandler::dispatchPending()
+{
+	dispatching = true;
+	{
+		const DispatchTable& table = acquireDispatchTable();
+
+		const size_t consumed = collectBatch(table);
+		const bool parallel = workerPool != nullptr && !table.actors.empty();
+
+		// In parallel mode and if executors are registered, the events are
+		// moved out of the queue and shared with the pool and the
+		// executors. The dispatcher's listeners use the same copy.
+		SharedEventBatch* shared{ nullptr };
+		if ((parallel || !table.executors.empty()) && !collectedEvents.empty())
+		{
+			const size_t actorCount = parallel ? table.actors.size() : 0;
+			shared = shareBatch(static_cast<uint32_t>(actorCount + table.executors.size()));
+			if (parallel) {
+				postToActors(table, shared);
+			}
+			postToExecutors(table, shared);
+		}
+		const EventBatch batch = shared != nullptr
+			? EventBatch(shared->pointers.data(), shared->pointers.size())
+			: EventBatch(currentBatch.data(), currentBatch.size());
+
+		const bool trackLatency = LatencyTracker::isEnabled();
+		if (trackLatency) {
+			LatencyTracker::recordDispatch(batch);
+		}
+
+		for (const auto& entry : table.listeners)
 		{
-			auto e = std::shared_ptr<Event> (pendingEvents.front());
-			pendingEvents.pop();
+			if (entry->executor != nullptr) continue;
+			if (parallel && entry->actor != nullptr) continue;
+			if (!entry->enter()) continue;
+
+			entry->listener->onEvents(batch);
+			entry->leave();
+			if (trackLatency) {
+				LatencyTracker::recordDelivery(batch);
+			}
+		}
 
-			listenerLock.lock();
-			for (auto listener : listeners)
+		// Only visit callbacks interested in the event's exact type
+		for (const Event* e : batch)
+		{
+			const EventTypeId type = e->getTypeId();
+			if (type < table.subscribers.size())
 			{
-				listener->onEvent(e);
+				for (const auto& sub : table.subscribers[type])
+				{
+					if (!sub->enter()) continue;
+
+					sub->callback(*e);
+					sub->leave();
+					if (trackLatency) {
+						LatencyTracker::recordDelivery(*e);
+					}
+				}
 			}
-			listenerLock.unlock();
 		}
+
+		if (shared != nullptr) {
+			releaseBatch(shared);
+		}
+		for (size_t i = 0; i < consumed; i++) {
+			pendingEvents->pop();
+		}
+	}
+	dispatching = false;
+}
+
+auto glb::EventHandler::collectBatch(const DispatchTable& table) -> size_t
+{
+	const auto& coalesceFuncs = table.coalesceFuncs;
+
+	currentBatch.clear();
+	collectedEvents.clear();
+
+	// Collect all published events. Events that are still being written
+	// by a producer are not waited for.
+	size_t count = 0;
+	StoredEvent* current = pendingEvents->peek(0);
+	while (current != nullptr)
+	{
+		StoredEvent* next = pendingEvents->peek(count + 1);
+
+		// Fold the event into its successor if both have the same type
+		// and coalescing is enabled for it. The folded event stays in the
+		// queue until the whole batch is popped.
+		const EventTypeId type = current->get().getTypeId();
+		if (next != nullptr
+			&& next->get().getTypeId() == type
+			&& type < coalesceFuncs.size()
+			&& coalesceFuncs[type] != nullptr)
+		{
+			coalesceFuncs[type](next->get(), current->get());
+		}
+		else {
+			currentBatch.push_back(&current->get());
+			collectedEvents.push_back(current);
+		}
+
+		current = next;
+		count++;
 	}
+
+	return count;
+}
+
+auto glb::EventHandler::acquireDispatchTable() -> const DispatchTable&
+{
+	// Only a changed version costs a lock
+	if (dispatchTable == nullptr
+		|| tableVersion.load(std::memory_order_acquire) != dispatchTableVersion)
+	{
+		std::lock_guard lock(tableLock);
+		dispatchTable = table;
+		dispatchTableVersion = tableVersion.load(std::memory_order_relaxed);
+	}
+
+	return *dispatchTable;
+}
+
+bool glb::EventHandler::handleFullQueue()
+{
+	// Nothing frees a slot once the event handler has been stopped
+	if (!running.load(std::memory_order_acquire))
+	{
+		droppedEventCount++;
+		return false;
+	}
+
+	// Other threads can rely on the consumer to free a slot eventually
+	if (consumerThread.load() != std::this_thread::get_id()) {
+		return true;
+	}
+
+	// A listener that notifies from within the dispatch loop would wait
+	// for itself
+	if (dispatching)
+	{
+		droppedEventCount++;
+		return false;
+	}
+
+	// In synchronous mode, the window's callbacks run on the dispatching
+	// thread. Make room by dispatching what we have.
+	dispatchPending();
+	return true;
+}
+
+auto glb::EventHandler::shareBatch(uint32_t refCount) -> SharedEventBatch*
+{
+	SharedEventBatch* batch = acquireBatch();
+
+	// Reserve first, the pointers must stay valid
+	batch->events.reserve(collectedEvents.size());
+	for (StoredEvent* e : collectedEvents) {
+		batch->events.emplace_back(std::move(*e));
+	}
+	for (const StoredEvent& e : batch->events) {
+		batch->pointers.push_back(&e.get());
+	}
+
+	// One additional reference for the dispatcher thread
+	batch->refCount.store(refCount + 1, std::memory_order_relaxed);
+
+	return batch;
+}
+
+void glb::EventHandler::postToActors(const DispatchTable& table, SharedEventBatch* batch)
+{
+	for (const auto& actor : table.actors)
+	{
+		bool schedule{ false };
+		{
+			std::lock_guard lock(actor->lock);
+			actor->mailbox.push_back(batch);
+			schedule = !actor->scheduled;
+			actor->scheduled = true;
+		}
+
+		// An actor that is already scheduled picks up the batch itself, so
+		// that its listeners never run on two threads at once
+		if (schedule) {
+			workerPool->submit([actor]() { runActor(*actor); });
+		}
+	}
+}
+
+void glb::EventHandler::runActor(DispatchActor& actor)
+{
+	std::unique_lock lock(actor.lock);
+	while (!actor.mailbox.empty())
+	{
+		std::swap(actor.mailbox, actor.processing);
+		for (SharedEventBatch* batch : actor.processing)
+		{
+			const EventBatch events(batch->pointers.data(), batch->pointers.size());
+
+			// Members may be added or removed while the lock is released,
+			// but never erased while the actor is scheduled
+			for (size_t i = 0; i < actor.members.size(); i++)
+			{
+				Listener* listener = actor.members[i];
+				if (listener == nullptr) continue;
+
+				actor.current = listener;
+				actor.currentThread = std::this_thread::get_id();
+				lock.unlock();
+				listener->onEvents(events);
+				if (LatencyTracker::isEnabled()) {
+					LatencyTracker::recordDelivery(events);
+				}
+				lock.lock();
+				actor.current = nullptr;
+				actor.idle.notify_all();
+			}
+
+			releaseBatch(batch);
+		}
+		actor.processing.clear();
+	}
+
+	actor.scheduled = false;
+	actor.members.erase(
+		std::remove(actor.members.begin(), actor.members.end(), nullptr),
+		actor.members.end()
+	);
+}
+
+void glb::EventHandler::postToExecutors(const DispatchTable& table, SharedEventBatch* batch)
+{
+	for (const auto& queue : table.executors)
+	{
+		// The executor is being destroyed
+		if (!queue->enter())
+		{
+			releaseBatch(batch);
+			continue;
+		}
+
+		while (!queue->batches.tryEmplace(batch))
+		{
+			// The owner can't drain the queue while we wait for it. If it
+			// is already draining, it has called us from a listener.
+			if (queue->owner == std::this_thread::get_id())
+			{
+				if (runExecutor(*queue) == 0)
+				{
+					droppedEventCount += batch->pointers.size();
+					releaseBatch(batch);
+					break;
+				}
+			}
+			else if (queue->removed.load())
+			{
+				releaseBatch(batch);
+				break;
+			}
+			else {
+				std::this_thread::yield();
+			}
+		}
+		queue->leave();
+	}
+}
+
+auto glb::EventHandler::runExecutor(ExecutorQueue& queue) -> size_t
+{
+	std::unique_lock lock(queue.lock);
+	if (queue.draining) return 0;
+	queue.draining = true;
+
+	size_t count = 0;
+	while (!queue.batches.empty())
+	{
+		SharedEventBatch* batch = queue.batches.front();
+		queue.batches.pop();
+
+		const EventBatch events(batch->pointers.data(), batch->pointers.size());
+		for (size_t i = 0; i < queue.members.size(); i++)
+		{
+			Listener* listener = queue.members[i];
+			if (listener == nullptr) continue;
+
+			queue.current = listener;
+			lock.unlock();
+			listener->onEvents(events);
+			if (LatencyTracker::isEnabled()) {
+				LatencyTracker::recordDelivery(events);
+			}
+			lock.lock();
+			queue.current = nullptr;
+			queue.idle.notify_all();
+		}
+
+		releaseBatch(batch);
+		count++;
+	}
+
+	queue.draining = false;
+	queue.members.erase(
+		std::remove(queue.members.begin(), queue.members.end(), nullptr),
+		queue.members.end()
+	);
+
+	return count;
+}
+
+void glb::EventHandler::closeExecutor(const std::shared_ptr<ExecutorQueue>& queue)
+{
+	std::vector<std::shared_ptr<ListenerEntry>> entries;
+	modifyTable([&](DispatchTable& t) {
+		auto it = std::find(t.executors.begin(), t.executors.end(), queue);
+		if (it != t.executors.end()) {
+			t.executors.erase(it);
+		}
+
+		auto end = std::stable_partition(t.listeners.begin(), t.listeners.end(),
+										 [&queue](const auto& e) { return e->executor != queue; });
+		std::move(end, t.listeners.end(), std::back_inserter(entries));
+		t.listeners.erase(end, t.listeners.end());
+	});
+
+	// The dispatcher never calls these listeners itself
+	for (const auto& entry : entries) {
+		entry->retire(false);
+	}
+
+	// Wait until the dispatcher has stopped pushing to the queue
+	queue->retire(consumerThread.load() != std::this_thread::get_id());
+
+	std::lock_guard lock(queue->lock);
+	while (!queue->batches.empty())
+	{
+		releaseBatch(queue->batches.front());
+		queue->batches.pop();
+	}
+	queue->members.clear();
+}
+
+auto glb::EventHandler::acquireBatch() -> SharedEventBatch*
+{
+	std::lock_guard lock(batchPoolLock);
+
+	if (freeBatches.empty())
+	{
+		batchPool.push_back(std::make_unique<SharedEventBatch>());
+		return batchPool.back().get();
+	}
+
+	SharedEventBatch* batch = freeBatches.back();
+	freeBatches.pop_back();
+	return batch;
+}
+
+void glb::EventHandler::releaseBatch(SharedEventBatch* batch)
+{
+	if (batch->refCount.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+	// Keeps the capacity of both vectors
+	batch->events.clear();
+	batch->pointers.clear();
+
+	std::lock_guard lock(batchPoolLock);
+	freeBatches.push_back(batch);
+}
+
+void glb::EventHandler::waitForEvents()
+{
+	for (uint32_t i = 0; i < spinCount; i++)
+	{
+		if (!pendingEvents->empty() || stopRequested) return;
+		cpuRelax();
+	}
+
+	// Announce that we're about to sleep, then check the queue again. A
+	// producer that published its event before it could observe the flag
+	// is seen here, all others will wake us up.
+	dispatcherParked.store(true);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!pendingEvents->empty() || stopRequested)
+	{
+		dispatcherParked.store(false);
+		return;
+	}
+
+	// Read after the flag has been set. A timer that is scheduled later
+	// wakes us up like an event does.
+	const auto deadline = timers.getNextDeadline();
+
+	std::unique_lock lock(wakeLock);
+	if (deadline.has_value())
+	{
+		wakeCondition.wait_until(lock, *deadline, [] { return !dispatcherParked.load(); });
+		dispatcherParked.store(false);
+	}
+	else {
+		wakeCondition.wait(lock, [] { return !dispatcherParked.load(); });
+	}
+}
+
+void glb::EventHandler::wakeDispatcher()
+{
+	// The dispatcher only parks on an empty queue, so this is only true
+	// for the first event after the queue has run empty. The exchange
+	// ensures that only one producer pays for the wake-up.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (dispatcherParked.load(std::memory_order_relaxed)
+		&& dispatcherParked.exchange(false))
+	{
+		std::lock_guard lock(wakeLock);
+		wakeCondition.notify_one();
+	}
+}
+
+glb::EventHandler::DispatcherThread::~DispatcherThread()
+{
+	if (thread.joinable())
+	{
+		stopRequested = true;
+		wakeDispatcher();
+		thread.join();
+	}
+}
+
+
+
+glb::EventSubscription::EventSubscription(EventTypeId type, uint64_t id)
+	:
+	type(type),
+	id(id)
+{
+}
+
+glb::EventSubscription::EventSubscription(EventSubscription&& other) noexcept
+	:
+	type(other.type),
+	id(other.id)
+{
+	other.type = INVALID_EVENT_TYPE_ID;
+}
+
+auto glb::EventSubscription::operator=(EventSubscription&& rhs) noexcept -> EventSubscription&
+{
+	if (this != &rhs)
+	{
+		unsubscribe();
+		type = rhs.type;
+		id = rhs.id;
+		rhs.type = INVALID_EVENT_TYPE_ID;
+	}
+	return *this;
+}
+
+glb::EventSubscription::~EventSubscription()
+{
+	unsubscribe();
+}
+
+void glb::EventSubscription::unsubscribe()
+{
+	if (type == INVALID_EVENT_TYPE_ID) return;
+
+	EventHandler::removeSubscriber(type, id);
+	type = INVALID_EVENT_TYPE_ID;
+}
+
+
+
+glb::EventExecutor::EventExecutor()
+	:
+	EventExecutor(DEFAULT_EXECUTOR_QUEUE_CAPACITY)
+{
+}
+
+glb::EventExecutor::EventExecutor(size_t queueCapacity)
+	:
+	queue(std::make_shared<EventHandler::ExecutorQueue>(queueCapacity))
+{
+}
+
+glb::EventExecutor::~EventExecutor()
+{
+	EventHandler::closeExecutor(queue);
+}
+
+auto glb::EventExecutor::drain() -> size_t
+{
+	if (queue->owner != std::this_thread::get_id()) {
+		throw std::runtime_error("EventExecutor::drain() must be called on the thread that created the executor");
+	}
+
+	return EventHandler::runExecutor(*queue);
+}
+
+auto glb::EventExecutor::getOwnerThread() const noexcept -> std::thread::id
+{
+	return queue->owner;
 }
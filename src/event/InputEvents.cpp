@@ -11,13 +11,15 @@ glb::KeyEvent::KeyEvent(eKey key, eKeyMod mods)
 
 
 glb::MouseEvent::MouseEvent(vec2 cursorPosition)
+	:
+	position(cursorPosition)
 {
-	cursorPos = cursorPosition;
 }
 
 
-glb::MouseButtonEvent::MouseButtonEvent(eMouseButton button, eKeyMod mods)
+glb::MouseButtonEvent::MouseButtonEvent(eMouseButton button, eKeyMod mods, vec2 cursorPosition)
 	:
+	MouseEvent(cursorPosition),
 	button(button),
 	mods(mods)
 {
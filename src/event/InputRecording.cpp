@@ -0,0 +1,319 @@
+#include "event/InputRecording.h"
+
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <stdexcept>
+
+#include "event/EventHandler.h"
+#include "event/InputEvents.h"
+#include "Window.h"
+
+
+
+namespace
+{
+	constexpr char MAGIC[8] = { 'G', 'L', 'B', 'I', 'N', 'P', 'U', 'T' };
+	// Version 2 stores the cursor position of all mouse events
+	constexpr uint32_t VERSION = 2;
+
+	// Stored in the file, never change existing values
+	enum RecordTag : uint8_t
+	{
+		TAG_KEY_PRESS = 1,
+		TAG_KEY_RELEASE,
+		TAG_MOUSE_BUTTON_PRESS,
+		TAG_MOUSE_BUTTON_RELEASE,
+		TAG_MOUSE_MOVE,
+		TAG_MOUSE_SCROLL,
+		TAG_WINDOW_CREATE,
+		TAG_WINDOW_CLOSE,
+		TAG_WINDOW_RESIZE,
+		TAG_MOUSE_MOTION,
+	};
+
+	template<typename T>
+	inline void write(std::ostream& os, T value)
+	{
+		os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	inline auto read(std::istream& is) -> T
+	{
+		T value{};
+		is.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return value;
+	}
+
+	// The event's type id is the static type it was notified with, so a
+	// simple comparison identifies it
+	auto getTag(glb::EventTypeId type) -> uint8_t
+	{
+		using namespace glb;
+
+		if (type == getEventTypeId<KeyPressEvent>())           return TAG_KEY_PRESS;
+		if (type == getEventTypeId<KeyReleaseEvent>())         return TAG_KEY_RELEASE;
+		if (type == getEventTypeId<MouseButtonPressEvent>())   return TAG_MOUSE_BUTTON_PRESS;
+		if (type == getEventTypeId<MouseButtonReleaseEvent>()) return TAG_MOUSE_BUTTON_RELEASE;
+		if (type == getEventTypeId<MouseMoveEvent>())          return TAG_MOUSE_MOVE;
+		if (type == getEventTypeId<MouseMotionEvent>())        return TAG_MOUSE_MOTION;
+		if (type == getEventTypeId<MouseScrollEvent>())        return TAG_MOUSE_SCROLL;
+		if (type == getEventTypeId<WindowCreateEvent>())       return TAG_WINDOW_CREATE;
+		if (type == getEventTypeId<WindowCloseEvent>())        return TAG_WINDOW_CLOSE;
+		if (type == getEventTypeId<WindowResizeEvent>())       return TAG_WINDOW_RESIZE;
+		return 0;
+	}
+} // anonymous namespace
+
+
+
+void glb::InputRecorder::start(const fs::path& path)
+{
+	stop();
+
+	std::lock_guard guard(lock);
+
+	file.open(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Unable to open input recording file " + path.string());
+	}
+	file.write(MAGIC, sizeof(MAGIC));
+	write(file, VERSION);
+
+	recordedEvents = 0;
+	startTime = Clock::now();
+	recording = true;
+}
+
+void glb::InputRecorder::stop()
+{
+	std::lock_guard guard(lock);
+
+	if (!recording) return;
+	recording = false;
+	file.close();
+}
+
+auto glb::InputRecorder::getRecordedEventCount() -> size_t
+{
+	std::lock_guard guard(lock);
+	return recordedEvents;
+}
+
+void glb::InputRecorder::record(const Event& event)
+{
+	const uint8_t tag = getTag(event.getTypeId());
+	if (tag == 0) return;
+
+	std::lock_guard guard(lock);
+	if (!recording) return;
+
+	// Use the time at which the event was created, not when it arrived
+	// here. Events created before the start are recorded at time zero.
+	const auto time = std::max(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(event.getTimestamp() - startTime),
+		std::chrono::nanoseconds::zero()
+	);
+	write(file, tag);
+	write(file, static_cast<int64_t>(time.count()));
+
+	switch (tag)
+	{
+	case TAG_KEY_PRESS:
+	case TAG_KEY_RELEASE:
+	{
+		const auto& e = static_cast<const KeyEvent&>(event);
+		write(file, static_cast<int32_t>(e.key));
+		write(file, static_cast<int32_t>(e.mods));
+		break;
+	}
+	case TAG_MOUSE_BUTTON_PRESS:
+	case TAG_MOUSE_BUTTON_RELEASE:
+	{
+		const auto& e = static_cast<const MouseButtonEvent&>(event);
+		write(file, static_cast<int32_t>(e.button));
+		write(file, static_cast<int32_t>(e.mods));
+		write(file, static_cast<float>(e.position.x));
+		write(file, static_cast<float>(e.position.y));
+		break;
+	}
+	case TAG_MOUSE_MOVE:
+	{
+		const auto& e = static_cast<const MouseMoveEvent&>(event);
+		write(file, static_cast<float>(e.position.x));
+		write(file, static_cast<float>(e.position.y));
+		break;
+	}
+	case TAG_MOUSE_MOTION:
+	{
+		const auto& e = static_cast<const MouseMotionEvent&>(event);
+		write(file, static_cast<float>(e.delta.x));
+		write(file, static_cast<float>(e.delta.y));
+		write(file, static_cast<float>(e.position.x));
+		write(file, static_cast<float>(e.position.y));
+		break;
+	}
+	case TAG_MOUSE_SCROLL:
+	{
+		const auto& e = static_cast<const MouseScrollEvent&>(event);
+		write(file, static_cast<float>(e.scrollOffset.x));
+		write(file, static_cast<float>(e.scrollOffset.y));
+		write(file, static_cast<float>(e.position.x));
+		write(file, static_cast<float>(e.position.y));
+		break;
+	}
+	case TAG_WINDOW_RESIZE:
+	{
+		const auto& e = static_cast<const WindowResizeEvent&>(event);
+		write(file, static_cast<int32_t>(e.oldSize.x));
+		write(file, static_cast<int32_t>(e.oldSize.y));
+		write(file, static_cast<int32_t>(e.newSize.x));
+		write(file, static_cast<int32_t>(e.newSize.y));
+		break;
+	}
+	default:
+		break;
+	}
+
+	recordedEvents++;
+}
+
+
+
+glb::InputReplay::InputReplay(const fs::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		throw std::runtime_error("Unable to open input recording file " + path.string());
+	}
+
+	char magic[sizeof(MAGIC)];
+	file.read(magic, sizeof(magic));
+	const auto version = read<uint32_t>(file);
+	if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+		throw std::runtime_error(path.string() + " is not a valid input recording");
+	}
+
+	while (true)
+	{
+		Record rec{};
+		rec.tag = read<uint8_t>(file);
+		if (file.eof()) break;
+		rec.time = std::chrono::nanoseconds(read<int64_t>(file));
+
+		switch (rec.tag)
+		{
+		case TAG_KEY_PRESS:
+		case TAG_KEY_RELEASE:
+			rec.ints[0] = read<int32_t>(file);
+			rec.ints[1] = read<int32_t>(file);
+			break;
+		case TAG_MOUSE_BUTTON_PRESS:
+		case TAG_MOUSE_BUTTON_RELEASE:
+			rec.ints[0] = read<int32_t>(file);
+			rec.ints[1] = read<int32_t>(file);
+			rec.floats[2] = read<float>(file);
+			rec.floats[3] = read<float>(file);
+			break;
+		case TAG_MOUSE_MOVE:
+			rec.floats[0] = read<float>(file);
+			rec.floats[1] = read<float>(file);
+			break;
+		case TAG_MOUSE_MOTION:
+		case TAG_MOUSE_SCROLL:
+			for (auto& f : rec.floats) {
+				f = read<float>(file);
+			}
+			break;
+		case TAG_WINDOW_RESIZE:
+			for (auto& i : rec.ints) {
+				i = read<int32_t>(file);
+			}
+			break;
+		case TAG_WINDOW_CREATE:
+		case TAG_WINDOW_CLOSE:
+			break;
+		default:
+			throw std::runtime_error(path.string() + " contains an unknown event type");
+		}
+
+		if (!file) {
+			throw std::runtime_error(path.string() + " is truncated");
+		}
+		records.push_back(rec);
+	}
+}
+
+void glb::InputReplay::play(ReplayTiming timing) const
+{
+	const auto start = Clock::now();
+	for (const auto& rec : records)
+	{
+		if (timing == ReplayTiming::original) {
+			std::this_thread::sleep_until(start + rec.time);
+		}
+
+		switch (rec.tag)
+		{
+		case TAG_KEY_PRESS:
+			EventHandler::notify(KeyPressEvent(eKey(rec.ints[0]), eKeyMod(rec.ints[1])));
+			break;
+		case TAG_KEY_RELEASE:
+			EventHandler::notify(KeyReleaseEvent(eKey(rec.ints[0]), eKeyMod(rec.ints[1])));
+			break;
+		case TAG_MOUSE_BUTTON_PRESS:
+			EventHandler::notify(MouseButtonPressEvent(
+				eMouseButton(rec.ints[0]), eKeyMod(rec.ints[1]),
+				vec2(rec.floats[2], rec.floats[3])
+			));
+			break;
+		case TAG_MOUSE_BUTTON_RELEASE:
+			EventHandler::notify(MouseButtonReleaseEvent(
+				eMouseButton(rec.ints[0]), eKeyMod(rec.ints[1]),
+				vec2(rec.floats[2], rec.floats[3])
+			));
+			break;
+		case TAG_MOUSE_MOVE:
+			EventHandler::notify(MouseMoveEvent(vec2(rec.floats[0], rec.floats[1])));
+			break;
+		case TAG_MOUSE_MOTION:
+			EventHandler::notify(MouseMotionEvent(
+				vec2(rec.floats[0], rec.floats[1]),
+				vec2(rec.floats[2], rec.floats[3])
+			));
+			break;
+		case TAG_MOUSE_SCROLL:
+			EventHandler::notify(MouseScrollEvent(
+				vec2(rec.floats[0], rec.floats[1]),
+				vec2(rec.floats[2], rec.floats[3])
+			));
+			break;
+		case TAG_WINDOW_CREATE:
+			EventHandler::notify(WindowCreateEvent());
+			break;
+		case TAG_WINDOW_CLOSE:
+			EventHandler::notify(WindowCloseEvent());
+			break;
+		case TAG_WINDOW_RESIZE:
+			EventHandler::notify(WindowResizeEvent(
+				ivec2(rec.ints[0], rec.ints[1]),
+				ivec2(rec.ints[2], rec.ints[3])
+			));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+auto glb::InputReplay::size() const noexcept -> size_t
+{
+	return records.size();
+}
+
+auto glb::InputReplay::getDuration() const noexcept -> Clock::duration
+{
+	if (records.empty()) return Clock::duration::zero();
+	return std::chrono::duration_cast<Clock::duration>(records.back().time);
+}
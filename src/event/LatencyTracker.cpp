@@ -0,0 +1,262 @@
+#include "event/LatencyTracker.h"
+
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUG__)
+	#include <cxxabi.h>
+	#include <cstdlib>
+#endif
+
+
+
+namespace
+{
+	constexpr const char* STAGE_NAMES[] = { "dispatch", "delivery", "frame" };
+
+	auto demangle(const char* name) -> std::string
+	{
+#if defined(__GNUG__)
+		int status = 0;
+		char* result = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+		if (status == 0 && result != nullptr)
+		{
+			std::string demangled(result);
+			std::free(result);
+			return demangled;
+		}
+#endif
+		return name;
+	}
+
+	inline auto toNanoseconds(glb::Clock::duration d) noexcept -> uint64_t
+	{
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+		return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+	}
+
+	inline auto toMicroseconds(glb::Clock::duration d) noexcept -> double
+	{
+		return std::chrono::duration<double, std::micro>(d).count();
+	}
+} // anonymous namespace
+
+
+
+void glb::LatencyHistogram::record(Clock::duration duration) noexcept
+{
+	const uint64_t ns = toNanoseconds(duration);
+
+	buckets[getBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t prevMax = max.load(std::memory_order_relaxed);
+	while (ns > prevMax && !max.compare_exchange_weak(prevMax, ns, std::memory_order_relaxed));
+}
+
+auto glb::LatencyHistogram::getCount() const noexcept -> uint64_t
+{
+	return count.load(std::memory_order_relaxed);
+}
+
+auto glb::LatencyHistogram::getPercentile(double percentile) const noexcept -> Clock::duration
+{
+	const uint64_t total = getCount();
+	if (total == 0) return Clock::duration::zero();
+
+	// The rank of the sample, 1-based
+	auto rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+	if (rank < 1) rank = 1;
+
+	uint64_t seen = 0;
+	for (uint32_t i = 0; i < BUCKET_COUNT; i++)
+	{
+		seen += buckets[i].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			return std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(getLowerBound(i)));
+		}
+	}
+	return getMax();
+}
+
+auto glb::LatencyHistogram::getMax() const noexcept -> Clock::duration
+{
+	return std::chrono::duration_cast<Clock::duration>(
+		std::chrono::nanoseconds(max.load(std::memory_order_relaxed))
+	);
+}
+
+void glb::LatencyHistogram::reset() noexcept
+{
+	for (auto& bucket : buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	count = 0;
+	max = 0;
+}
+
+auto glb::LatencyHistogram::getBucket(uint64_t nanoseconds) noexcept -> uint32_t
+{
+	// Values below SUB_BUCKETS have a bucket each
+	if (nanoseconds < SUB_BUCKETS) {
+		return static_cast<uint32_t>(nanoseconds);
+	}
+
+	uint32_t msb = 63;
+	while ((nanoseconds >> msb) == 0) msb--;
+
+	const uint32_t shift = msb - SUB_BUCKET_BITS;
+	const auto sub = static_cast<uint32_t>((nanoseconds >> shift) & (SUB_BUCKETS - 1));
+	return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+auto glb::LatencyHistogram::getLowerBound(uint32_t bucket) noexcept -> uint64_t
+{
+	if (bucket < SUB_BUCKETS) {
+		return bucket;
+	}
+
+	const uint32_t shift = bucket / SUB_BUCKETS - 1;
+	const uint64_t sub = bucket % SUB_BUCKETS;
+	return (SUB_BUCKETS + sub) << shift;
+}
+
+
+
+void glb::LatencyTracker::setEnabled(bool enable) noexcept
+{
+	enabled = enable;
+}
+
+auto glb::LatencyTracker::getStatistics(EventTypeId type, LatencyStage stage) -> LatencyStatistics
+{
+	if (type >= MAX_TRACKED_EVENT_TYPES) return {};
+
+	const TypeStatistics* stats = types[type].load(std::memory_order_acquire);
+	if (stats == nullptr) return {};
+
+	const auto& hist = stats->histograms[static_cast<size_t>(stage)];
+	return { hist.getCount(), hist.getPercentile(50.0), hist.getPercentile(99.0), hist.getMax() };
+}
+
+void glb::LatencyTracker::reset()
+{
+	for (auto& type : types)
+	{
+		TypeStatistics* stats = type.load(std::memory_order_acquire);
+		if (stats == nullptr) continue;
+
+		for (auto& hist : stats->histograms) {
+			hist.reset();
+		}
+	}
+
+	std::lock_guard lock(frameLock);
+	pendingFrame.clear();
+}
+
+void glb::LatencyTracker::writeReport(const fs::path& path)
+{
+	std::ofstream file(path);
+	if (!file) {
+		throw std::runtime_error("Unable to open latency report file " + path.string());
+	}
+
+	file << std::left << std::setw(40) << "event type" << std::setw(10) << "stage"
+		 << std::right << std::setw(12) << "count"
+		 << std::setw(12) << "p50 [us]" << std::setw(12) << "p99 [us]" << std::setw(12) << "max [us]"
+		 << "\n";
+	file << std::fixed << std::setprecision(2);
+
+	for (EventTypeId type = 0; type < MAX_TRACKED_EVENT_TYPES; type++)
+	{
+		const TypeStatistics* stats = types[type].load(std::memory_order_acquire);
+		if (stats == nullptr) continue;
+
+		const std::string name = demangle(stats->name);
+		for (size_t stage = 0; stage < static_cast<size_t>(LatencyStage::numStages); stage++)
+		{
+			const auto s = getStatistics(type, static_cast<LatencyStage>(stage));
+			file << std::left << std::setw(40) << name << std::setw(10) << STAGE_NAMES[stage]
+				 << std::right << std::setw(12) << s.count
+				 << std::setw(12) << toMicroseconds(s.p50)
+				 << std::setw(12) << toMicroseconds(s.p99)
+				 << std::setw(12) << toMicroseconds(s.max)
+				 << "\n";
+		}
+	}
+}
+
+void glb::LatencyTracker::recordFrame()
+{
+	if (!isEnabled()) return;
+
+	const auto now = Clock::now();
+	std::lock_guard lock(frameLock);
+	for (const auto& [type, timestamp] : pendingFrame)
+	{
+		// The statistics exist because the event has been dispatched
+		types[type].load(std::memory_order_acquire)
+			->histograms[static_cast<size_t>(LatencyStage::frame)].record(now - timestamp);
+	}
+	pendingFrame.clear();
+}
+
+void glb::LatencyTracker::recordDispatch(const EventBatch& events)
+{
+	const auto now = Clock::now();
+	std::lock_guard lock(frameLock);
+	for (const Event* e : events)
+	{
+		TypeStatistics* stats = getTypeStatistics(*e);
+		if (stats == nullptr) continue;
+
+		stats->histograms[static_cast<size_t>(LatencyStage::dispatch)].record(now - e->getTimestamp());
+
+		// Don't grow without bound if the application never swaps
+		if (pendingFrame.size() < MAX_PENDING_FRAME_EVENTS) {
+			pendingFrame.emplace_back(e->getTypeId(), e->getTimestamp());
+		}
+	}
+}
+
+void glb::LatencyTracker::recordDelivery(const EventBatch& events)
+{
+	const auto now = Clock::now();
+	for (const Event* e : events)
+	{
+		if (TypeStatistics* stats = getTypeStatistics(*e)) {
+			stats->histograms[static_cast<size_t>(LatencyStage::delivery)].record(now - e->getTimestamp());
+		}
+	}
+}
+
+void glb::LatencyTracker::recordDelivery(const Event& event)
+{
+	if (TypeStatistics* stats = getTypeStatistics(event)) {
+		stats->histograms[static_cast<size_t>(LatencyStage::delivery)].record(Clock::now() - event.getTimestamp());
+	}
+}
+
+auto glb::LatencyTracker::getTypeStatistics(const Event& event) -> TypeStatistics*
+{
+	const EventTypeId type = event.getTypeId();
+	if (type >= MAX_TRACKED_EVENT_TYPES) return nullptr;
+
+	TypeStatistics* stats = types[type].load(std::memory_order_acquire);
+	if (stats != nullptr) return stats;
+
+	// Named after the static type the id belongs to, not the event's
+	// dynamic type. Two threads may see the first event of a type at the
+	// same time.
+	const char* name = getEventTypeName(type);
+	auto created = new TypeStatistics{ name != nullptr ? name : "unknown", {} };
+	if (types[type].compare_exchange_strong(stats, created, std::memory_order_acq_rel)) {
+		return created;
+	}
+	delete created;
+	return stats;
+}
+
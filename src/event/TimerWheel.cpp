@@ -0,0 +1,338 @@
+#include "event/TimerWheel.h"
+
+#include <algorithm>
+
+
+
+glb::TimerWheel::TimerWheel()
+	:
+	TimerWheel(std::chrono::milliseconds(1))
+{
+}
+
+glb::TimerWheel::TimerWheel(Clock::duration resolution)
+	:
+	epoch(Clock::now()),
+	resolution(std::max(resolution, Clock::duration(1)))
+{
+	std::fill(std::begin(slots), std::end(slots), NIL);
+}
+
+auto glb::TimerWheel::schedule(
+	Clock::time_point deadline,
+	Clock::duration period,
+	std::function<void()> callback) -> TimerId
+{
+	auto shared = std::make_shared<const std::function<void()>>(std::move(callback));
+
+	std::lock_guard guard(lock);
+
+	uint32_t index;
+	if (freeNodes.empty())
+	{
+		index = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+	}
+	else
+	{
+		index = freeNodes.back();
+		freeNodes.pop_back();
+	}
+
+	Node& node = nodes[index];
+	if (++node.generation == 0) {
+		node.generation = 1;
+	}
+	node.deadline = std::max(toTick(deadline), currentTick + 1);
+	node.period = 0;
+	if (period > Clock::duration::zero()) {
+		node.period = std::max<uint64_t>((period + resolution - Clock::duration(1)) / resolution, 1);
+	}
+	node.callback = std::move(shared);
+
+	insert(index);
+	pendingCount++;
+
+	return (static_cast<uint64_t>(node.generation) << 32) | index;
+}
+
+bool glb::TimerWheel::cancel(TimerId id)
+{
+	const auto index = static_cast<uint32_t>(id & UINT32_MAX);
+	const auto generation = static_cast<uint32_t>(id >> 32);
+
+	std::lock_guard guard(lock);
+
+	if (index >= nodes.size()
+		|| nodes[index].generation != generation
+		|| nodes[index].slot == NIL)
+	{
+		return false;
+	}
+
+	unlink(index);
+	release(index);
+	pendingCount--;
+
+	return true;
+}
+
+auto glb::TimerWheel::advance(Clock::time_point now) -> size_t
+{
+	std::vector<Callback> callbacks;
+	{
+		std::lock_guard guard(lock);
+
+		// Round down, timers must not fire early
+		const auto elapsed = now - epoch;
+		const uint64_t nowTick = elapsed > Clock::duration::zero()
+			? static_cast<uint64_t>(elapsed / resolution)
+			: 0;
+
+		while (currentTick < nowTick)
+		{
+			// Skip ticks without work
+			const uint64_t tick = getNextWorkTick();
+			if (tick > nowTick)
+			{
+				currentTick = nowTick;
+				break;
+			}
+
+			// Timers are moved down relative to the previous tick, so that
+			// timers that expire at this tick end up in level 0
+			currentTick = tick - 1;
+			uint32_t level = 0;
+			while (level + 1 < LEVEL_COUNT
+				   && (tick & ((uint64_t(1) << (LEVEL_BITS * (level + 1))) - 1)) == 0)
+			{
+				level++;
+			}
+			for (; level > 0; level--) {
+				cascade(level);
+			}
+
+			currentTick = tick;
+			expire(static_cast<uint32_t>(tick & SLOT_MASK));
+		}
+
+		callbacks.swap(expired);
+	}
+
+	for (const auto& callback : callbacks) {
+		(*callback)();
+	}
+
+	// Hand the storage back for the next call
+	const size_t count = callbacks.size();
+	callbacks.clear();
+	std::lock_guard guard(lock);
+	if (expired.empty()) {
+		expired.swap(callbacks);
+	}
+
+	return count;
+}
+
+auto glb::TimerWheel::getNextDeadline() const -> std::optional<Clock::time_point>
+{
+	std::lock_guard guard(lock);
+
+	if (pendingCount == 0) return std::nullopt;
+	return toTimePoint(getNextWorkTick());
+}
+
+auto glb::TimerWheel::size() const -> size_t
+{
+	std::lock_guard guard(lock);
+	return pendingCount;
+}
+
+auto glb::TimerWheel::toTick(Clock::time_point time) const noexcept -> uint64_t
+{
+	// Round up, timers must not fire early
+	const auto elapsed = time - epoch;
+	if (elapsed <= Clock::duration::zero()) return 0;
+
+	return static_cast<uint64_t>((elapsed + resolution - Clock::duration(1)) / resolution);
+}
+
+auto glb::TimerWheel::toTimePoint(uint64_t tick) const noexcept -> Clock::time_point
+{
+	return epoch + resolution * static_cast<Clock::rep>(tick);
+}
+
+void glb::TimerWheel::insert(uint32_t index)
+{
+	Node& node = nodes[index];
+
+	// Relative to the next tick that is processed. A slot of a higher
+	// level that has already been moved down for that tick is only
+	// reached again after a full rotation.
+	const uint64_t base = currentTick + 1;
+	uint64_t deadline = std::max(node.deadline, base);
+	const uint64_t delta = deadline - base;
+
+	uint32_t level = 0;
+	while (level + 1 < LEVEL_COUNT && delta >= (uint64_t(1) << (LEVEL_BITS * (level + 1)))) {
+		level++;
+	}
+
+	// Too far in the future even for the last level. Park the timer in
+	// the last slot that is reached, it is placed again from there.
+	const uint64_t range = uint64_t(1) << (LEVEL_BITS * LEVEL_COUNT);
+	if (delta >= range) {
+		deadline = base + range - 1;
+	}
+
+	const auto slotInLevel = static_cast<uint32_t>((deadline >> (LEVEL_BITS * level)) & SLOT_MASK);
+	const uint32_t slot = level * SLOTS_PER_LEVEL + slotInLevel;
+
+	node.slot = slot;
+	node.prev = NIL;
+	node.next = slots[slot];
+	if (node.next != NIL) {
+		nodes[node.next].prev = index;
+	}
+	slots[slot] = index;
+	occupied[level][slotInLevel / 64] |= uint64_t(1) << (slotInLevel % 64);
+}
+
+void glb::TimerWheel::unlink(uint32_t index)
+{
+	Node& node = nodes[index];
+	const uint32_t slot = node.slot;
+
+	if (node.prev != NIL) {
+		nodes[node.prev].next = node.next;
+	}
+	else {
+		slots[slot] = node.next;
+	}
+	if (node.next != NIL) {
+		nodes[node.next].prev = node.prev;
+	}
+
+	if (slots[slot] == NIL)
+	{
+		const uint32_t slotInLevel = slot % SLOTS_PER_LEVEL;
+		occupied[slot / SLOTS_PER_LEVEL][slotInLevel / 64] &= ~(uint64_t(1) << (slotInLevel % 64));
+	}
+
+	node.prev = NIL;
+	node.next = NIL;
+}
+
+void glb::TimerWheel::release(uint32_t index)
+{
+	Node& node = nodes[index];
+	node.slot = NIL;
+	node.callback.reset();
+	freeNodes.push_back(index);
+}
+
+void glb::TimerWheel::cascade(uint32_t level)
+{
+	// The slot that the level has just reached
+	const auto slotInLevel = static_cast<uint32_t>(((currentTick + 1) >> (LEVEL_BITS * level)) & SLOT_MASK);
+	const uint32_t slot = level * SLOTS_PER_LEVEL + slotInLevel;
+
+	uint32_t index = slots[slot];
+	slots[slot] = NIL;
+	occupied[level][slotInLevel / 64] &= ~(uint64_t(1) << (slotInLevel % 64));
+
+	while (index != NIL)
+	{
+		const uint32_t next = nodes[index].next;
+		insert(index);
+		index = next;
+	}
+}
+
+void glb::TimerWheel::expire(uint32_t slotInLevel)
+{
+	// Detach the list first, periodic timers are inserted again
+	uint32_t index = slots[slotInLevel];
+	slots[slotInLevel] = NIL;
+	occupied[0][slotInLevel / 64] &= ~(uint64_t(1) << (slotInLevel % 64));
+
+	while (index != NIL)
+	{
+		Node& node = nodes[index];
+		const uint32_t next = node.next;
+
+		expired.push_back(node.callback);
+		if (node.period > 0)
+		{
+			// Skip the periods that have been missed
+			node.deadline += node.period;
+			if (node.deadline <= currentTick) {
+				node.deadline += ((currentTick - node.deadline) / node.period + 1) * node.period;
+			}
+			insert(index);
+		}
+		else
+		{
+			release(index);
+			pendingCount--;
+		}
+
+		index = next;
+	}
+}
+
+auto glb::TimerWheel::getNextWorkTick() const noexcept -> uint64_t
+{
+	// The earliest tick at which a slot of any level has to be processed
+	const uint64_t base = currentTick + 1;
+	uint64_t result = UINT64_MAX;
+	for (uint32_t level = 0; level < LEVEL_COUNT; level++)
+	{
+		const uint32_t shift = LEVEL_BITS * level;
+		const uint64_t rotation = uint64_t(1) << (shift + LEVEL_BITS);
+		const uint64_t rotationStart = base & ~(rotation - 1);
+		const auto position = static_cast<uint32_t>((base >> shift) & SLOT_MASK);
+
+		// The current slot of a higher level has already been moved down,
+		// unless that happens at the base tick itself
+		const bool currentIsPending = level == 0 || (base & ((uint64_t(1) << shift) - 1)) == 0;
+		const uint32_t from = currentIsPending ? position : position + 1;
+
+		uint64_t tick;
+		if (const auto slot = findNextOccupied(level, from)) {
+			tick = rotationStart + (uint64_t(*slot) << shift);
+		}
+		else if (const auto wrapped = findNextOccupied(level, 0)) {
+			tick = rotationStart + rotation + (uint64_t(*wrapped) << shift);
+		}
+		else {
+			continue;
+		}
+		result = std::min(result, tick);
+	}
+
+	return result;
+}
+
+auto glb::TimerWheel::findNextOccupied(uint32_t level, uint32_t fromSlot) const noexcept
+	-> std::optional<uint32_t>
+{
+	for (uint32_t word = fromSlot / 64; word < WORD_COUNT; word++)
+	{
+		uint64_t bits = occupied[level][word];
+		if (word == fromSlot / 64) {
+			bits &= ~uint64_t(0) << (fromSlot % 64);
+		}
+		if (bits == 0) continue;
+
+		uint32_t bit = 0;
+		while ((bits & 1) == 0)
+		{
+			bits >>= 1;
+			bit++;
+		}
+		return word * 64 + bit;
+	}
+
+	return std::nullopt;
+}
@@ -0,0 +1,132 @@
+/*
+ * Regression test: notify() after EventHandler::terminate() must discard
+ * the event instead of blocking on a full queue that nobody drains, and
+ * the event handler must work again after a restart, with the queue
+ * configuration passed to the new init().
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "glb/event/EventHandler.h"
+#include "glb/event/InputEvents.h"
+
+using namespace glb;
+
+
+
+namespace
+{
+	constexpr size_t QUEUE_CAPACITY = 4;
+	constexpr size_t LARGE_QUEUE_CAPACITY = 4096;
+	constexpr size_t EVENT_COUNT = 1000;
+	constexpr auto TIMEOUT = std::chrono::seconds(5);
+
+	void fail(const char* message)
+	{
+		std::fprintf(stderr, "FAILED: %s\n", message);
+		std::exit(1);
+	}
+
+	auto makeCreateInfo(EventDispatchMode mode) -> EventHandler::EventHandlerCreateInfo
+	{
+		EventHandler::EventHandlerCreateInfo info;
+		info.dispatchMode = mode;
+		info.queueCapacity = QUEUE_CAPACITY;
+		info.overflowPolicy = QueueOverflowPolicy::block;
+		return info;
+	}
+
+	// Notifies from another thread, which never counts as the consumer
+	void notifyAfterTerminate(EventDispatchMode mode)
+	{
+		EventHandler::init(makeCreateInfo(mode));
+		EventHandler::terminate();
+
+		auto done = std::async(std::launch::async, []() {
+			for (size_t i = 0; i < EVENT_COUNT; i++) {
+				EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(i), 0.0f)));
+			}
+		});
+		if (done.wait_for(TIMEOUT) != std::future_status::ready) {
+			fail("notify() blocked after terminate()");
+		}
+	}
+
+	void deliverAfterRestart()
+	{
+		EventHandler::init(makeCreateInfo(EventDispatchMode::asynchronous));
+
+		std::atomic<size_t> received{ 0 };
+		auto sub = EventHandler::subscribe<MouseMoveEvent>([&](const MouseMoveEvent&) {
+			received++;
+		});
+		for (size_t i = 0; i < EVENT_COUNT; i++) {
+			EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(i), 0.0f)));
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+		while (received < EVENT_COUNT && std::chrono::steady_clock::now() < deadline) {
+			std::this_thread::yield();
+		}
+		sub.unsubscribe();
+		EventHandler::terminate();
+
+		if (received != EVENT_COUNT) {
+			fail("events were lost after a restart");
+		}
+	}
+
+	// Notifies while the dispatcher is stuck in the first event, so all
+	// others have to fit into the queue
+	auto countDropsWithCapacity(size_t capacity) -> size_t
+	{
+		auto info = makeCreateInfo(EventDispatchMode::asynchronous);
+		info.queueCapacity = capacity;
+		info.overflowPolicy = QueueOverflowPolicy::dropNewest;
+		EventHandler::init(info);
+
+		const size_t droppedBefore = EventHandler::getDroppedEventCount();
+		std::atomic<bool> release{ false };
+		auto sub = EventHandler::subscribe<MouseMoveEvent>([&](const MouseMoveEvent&) {
+			while (!release) std::this_thread::yield();
+		});
+		for (size_t i = 0; i < EVENT_COUNT; i++) {
+			EventHandler::notify(MouseMoveEvent(vec2(static_cast<float>(i), 0.0f)));
+		}
+		const size_t dropped = EventHandler::getDroppedEventCount() - droppedBefore;
+
+		release = true;
+		EventHandler::terminate();
+		sub.unsubscribe();
+
+		return dropped;
+	}
+
+	void applyConfigAfterRestart()
+	{
+		if (countDropsWithCapacity(QUEUE_CAPACITY) == 0) {
+			fail("a small queue did not drop events");
+		}
+		if (countDropsWithCapacity(LARGE_QUEUE_CAPACITY) != 0) {
+			fail("init() kept the queue of the previous run");
+		}
+	}
+} // anonymous namespace
+
+
+
+int main()
+{
+	notifyAfterTerminate(EventDispatchMode::asynchronous);
+	notifyAfterTerminate(EventDispatchMode::synchronous);
+	deliverAfterRestart();
+	applyConfigAfterRestart();
+
+	std::printf("passed\n");
+	return 0;
+}